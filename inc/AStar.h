@@ -0,0 +1,29 @@
+#ifndef A_STAR_H
+#define A_STAR_H
+
+#include <CompactGraph.h>
+#include <cmath>
+
+// A* potential from the airport map coordinates: the straight-line distance
+// to the target scaled by the lowest per-unit-distance ratio of any arc.
+// No path can beat that ratio on every leg, so the bound never overestimates.
+// Rounding down keeps it consistent because arc weights are integers, and
+// the small shrink guards against the ratio itself rounding upward.
+struct GeometricPotential {
+  const CompactGraph *graph;
+  int target;
+  double ratio;
+
+  GeometricPotential(const CompactGraph &graph, int target,
+                     SearchCriteria criteria) {
+    this->graph = &graph;
+    this->target = target;
+    this->ratio = graph.perUnit(criteria) * (1 - 1e-9);
+  }
+
+  int operator()(int v) const {
+    return (int)std::floor(ratio * graph->distance(v, target));
+  }
+};
+
+#endif
@@ -0,0 +1,208 @@
+#ifndef ALL_PAIRS_TABLE_H
+#define ALL_PAIRS_TABLE_H
+
+#include <CompactGraph.h>
+#include <Dijkstra.h>
+#include <Parallel.h>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Precomputed shortest path lengths between every pair of vertices, with
+// a next-hop matrix to rebuild the paths, for networks small enough to
+// spend n^2 memory on instant answers.
+// For each criteria built, entry [s * n + t] holds d(s, t) and the first
+// arc of a shortest s-t path, stored as its position among s's arcs in 16
+// bits, so a criteria costs 6 n^2 bytes (150 MB at 5000 vertices).
+// Following next hops from s gives a shortest path, since the first arc of
+// a shortest path is followed by a shortest path from its head.
+// The tables are filled by one one-to-all Dijkstra per source, spread over
+// worker threads that each own an engine and write only their own rows.
+class AllPairsTable {
+  static constexpr unsigned short NO_HOP = 0xffff;
+
+  int n;
+  bool built[3];
+  std::vector<int> dist[3];
+  std::vector<unsigned short> hop[3];
+
+  // Fills row s of every requested criteria
+  void fillRow(const CompactGraph &g, int s, Dijkstra &engine,
+               std::vector<int> &first, std::vector<int> &climb) {
+    long row = (long)s * n;
+    for (int c = 0; c < 3; c++) {
+      if (!built[c]) {
+        continue;
+      }
+      engine.run(g, s, -1, (SearchCriteria)c);
+
+      // First arc of each tree path, shared down the tree through first[]
+      std::fill(first.begin(), first.end(), -1);
+      for (int v = 0; v < n; v++) {
+        if (v == s || !engine.reached(v)) {
+          continue;
+        }
+        int u = v;
+        while (first[u] == -1 && engine.parentOf(u) != s) {
+          climb.push_back(u);
+          u = engine.parentOf(u);
+        }
+        if (first[u] == -1) {
+          first[u] = engine.arcTo(u);
+        }
+        for (int w : climb) {
+          first[w] = first[u];
+        }
+        climb.clear();
+      }
+
+      for (int v = 0; v < n; v++) {
+        dist[c][row + v] = engine.distance(v);
+        hop[c][row + v] =
+            first[v] == -1 ? NO_HOP : (unsigned short)(first[v] - g.begin(s));
+      }
+    }
+  }
+
+public:
+  // Graph::version of the snapshot the tables belong to, -1 if empty
+  long version;
+
+  AllPairsTable() {
+    n = 0;
+    version = -1;
+    for (int c = 0; c < 3; c++) {
+      built[c] = false;
+    }
+  }
+
+  // Builds the tables of the given criteria on up to threads workers
+  AllPairsTable(const CompactGraph &g,
+                const std::vector<SearchCriteria> &modes =
+                    std::vector<SearchCriteria>{CHEAPEST, FASTEST,
+                                                LEAST_STOPS},
+                int threads = defaultThreads())
+      : AllPairsTable() {
+    n = g.vertexCount();
+    version = g.version;
+    for (int u = 0; u < n; u++) {
+      if (g.degree(u) >= NO_HOP) {
+        throw std::logic_error("Too many flights from one airport to index");
+      }
+    }
+    for (SearchCriteria mode : modes) {
+      built[mode] = true;
+      dist[mode].assign((long)n * n, UNREACHABLE);
+      hop[mode].assign((long)n * n, NO_HOP);
+    }
+
+    threads = std::max(1, threads);
+    std::vector<Dijkstra> engines(threads);
+    std::vector<std::vector<int>> first(threads, std::vector<int>(n));
+    std::vector<std::vector<int>> climb(threads);
+    parallelFor(n, threads, [&](int s, int worker) {
+      fillRow(g, s, engines[worker], first[worker], climb[worker]);
+    });
+  }
+
+  int vertexCount() const { return n; }
+
+  // True if the tables of criteria were built
+  bool has(SearchCriteria criteria) const { return built[criteria]; }
+
+  int distance(int s, int t, SearchCriteria criteria) const {
+    return dist[criteria][(long)s * n + t];
+  }
+
+  // First arc of a shortest s-t path, -1 if t is s or unreachable
+  int nextArc(const CompactGraph &g, int s, int t,
+              SearchCriteria criteria) const {
+    unsigned short h = hop[criteria][(long)s * n + t];
+    return h == NO_HOP ? -1 : g.begin(s) + h;
+  }
+
+  // Arcs of a shortest s-t path in travel order, empty if t is s or
+  // unreachable
+  std::vector<int> pathArcs(const CompactGraph &g, int s, int t,
+                            SearchCriteria criteria) const {
+    std::vector<int> arcs;
+    for (int u = s; u != t;) {
+      int arc = nextArc(g, u, t, criteria);
+      if (arc == -1) {
+        arcs.clear();
+        break;
+      }
+      arcs.push_back(arc);
+      u = g.targets[arc];
+      if ((int)arcs.size() > n) {
+        throw std::logic_error("Next-hop table does not lead to the target");
+      }
+    }
+    return arcs;
+  }
+
+  // Every shortest s-t path, at most limit of them unless limit is -1.
+  // Like OptimalPaths these are the simple paths over tight arcs, those
+  // with w(u, v) + d(v, t) = d(u, t); zero-weight arcs can make them cycle.
+  std::vector<std::vector<int>> allPathArcs(const CompactGraph &g, int s, int t,
+                                            SearchCriteria criteria,
+                                            int limit = -1) const {
+    std::vector<std::vector<int>> paths;
+    if (distance(s, t, criteria) == UNREACHABLE || limit == 0) {
+      return paths;
+    }
+
+    // Depth-first over tight arcs; each frame is a vertex and its next arc
+    std::vector<int> arcs;
+    std::vector<std::pair<int, int>> stack(1, std::make_pair(s, g.begin(s)));
+    std::vector<bool> onPath(n, false);
+    onPath[s] = true;
+    while (!stack.empty()) {
+      int u = stack.back().first;
+      if (u == t) {
+        paths.push_back(arcs);
+        if ((int)paths.size() == limit) {
+          break;
+        }
+      }
+
+      int arc = u == t ? g.end(u) : stack.back().second;
+      int remaining = distance(u, t, criteria);
+      for (; arc < g.end(u); arc++) {
+        int v = g.targets[arc];
+        int after = distance(v, t, criteria);
+        if (!onPath[v] && after != UNREACHABLE &&
+            g.weight(arc, criteria) + after == remaining) {
+          break;
+        }
+      }
+
+      if (arc == g.end(u)) {
+        onPath[u] = false;
+        stack.pop_back();
+        if (!arcs.empty()) {
+          arcs.pop_back();
+        }
+        continue;
+      }
+      stack.back().second = arc + 1;
+      arcs.push_back(arc);
+      onPath[g.targets[arc]] = true;
+      stack.push_back(std::make_pair(g.targets[arc], g.begin(g.targets[arc])));
+    }
+    return paths;
+  }
+
+  // Memory held by the tables
+  std::size_t bytes() const {
+    std::size_t total = 0;
+    for (int c = 0; c < 3; c++) {
+      total += dist[c].capacity() * sizeof(int) +
+               hop[c].capacity() * sizeof(unsigned short);
+    }
+    return total;
+  }
+};
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef BIDIRECTIONAL_DIJKSTRA_H
+#define BIDIRECTIONAL_DIJKSTRA_H
+
+#include <CompactGraph.h>
+#include <Dijkstra.h>
+#include <IndexedHeap.h>
+#include <SearchStats.h>
+#include <algorithm>
+#include <vector>
+
+// Point-to-point Dijkstra that grows one search forward from the source and
+// one backward from the target over the reverse index, always advancing the
+// side whose frontier is closer. It stops once the two frontier minima add
+// up to at least the best source-target connection seen so far, which on a
+// single pair settles roughly two half-radius balls instead of a full one.
+class BidirectionalDijkstra {
+  struct Side {
+    std::vector<int> dist;
+    std::vector<int> via;  // arc entering (forward) or leaving (backward)
+    std::vector<int> next; // neighbour toward this side's root
+    std::vector<unsigned> reachedIn;
+    std::vector<unsigned> settledIn;
+    IndexedHeap<int> frontier;
+
+    void prepare(int n) {
+      if ((int)dist.size() != n) {
+        frontier.clear();
+        dist.assign(n, UNREACHABLE);
+        via.assign(n, -1);
+        next.assign(n, -1);
+        reachedIn.assign(n, 0);
+        settledIn.assign(n, 0);
+        frontier.resize(n);
+      }
+      frontier.clear();
+    }
+  };
+
+  Side forward;
+  Side backward;
+  unsigned query;
+  int best;
+  int meeting;
+  SearchStats work;
+
+  bool reached(const Side &side, int v) const {
+    return side.reachedIn[v] == query;
+  }
+
+  void reach(Side &side, int v, int distance, int arc, int from) {
+    if (!side.frontier.contains(v)) {
+      work.pushed(forward.frontier.size() + backward.frontier.size() + 1);
+    } else {
+      work.decreaseKeys++;
+    }
+    side.dist[v] = distance;
+    side.via[v] = arc;
+    side.next[v] = from;
+    side.reachedIn[v] = query;
+    side.frontier.pushOrDecrease(v, distance);
+  }
+
+  // Settles the closest vertex of self and relaxes its arcs, forward arcs
+  // when self is the forward side and entering arcs when it is backward
+  void step(const CompactGraph &g, SearchCriteria criteria, Side &self,
+            Side &other, bool reverse) {
+    int u = self.frontier.pop();
+    self.settledIn[u] = query;
+    work.pops++;
+    work.settled++;
+
+    int first = reverse ? g.inBegin(u) : g.begin(u);
+    int last = reverse ? g.inEnd(u) : g.end(u);
+    for (int i = first; i < last; i++) {
+      int arc = reverse ? g.inArcs[i] : i;
+      int v = reverse ? g.sources[i] : g.targets[i];
+      work.relaxed++;
+      if (self.settledIn[v] == query) {
+        continue;
+      }
+
+      int candidate = self.dist[u] + g.weight(arc, criteria);
+      if (!reached(self, v) || candidate < self.dist[v]) {
+        reach(self, v, candidate, arc, u);
+      }
+
+      if (reached(other, v) && self.dist[v] + other.dist[v] < best) {
+        best = self.dist[v] + other.dist[v];
+        meeting = v;
+      }
+    }
+  }
+
+public:
+  BidirectionalDijkstra() {
+    query = 0;
+    best = UNREACHABLE;
+    meeting = -1;
+  }
+
+  // Finds a shortest source-target path; g must have its reverse index
+  void run(const CompactGraph &g, int source, int target,
+           SearchCriteria criteria) {
+    forward.prepare(g.vertexCount());
+    backward.prepare(g.vertexCount());
+    query++;
+    best = UNREACHABLE;
+    meeting = -1;
+    work.clear();
+    work.bytes = forward.frontier.bytes() + backward.frontier.bytes() +
+                 10 * g.vertexCount() * sizeof(int);
+
+    reach(forward, source, 0, -1, -1);
+    reach(backward, target, 0, -1, -1);
+    if (source == target) {
+      best = 0;
+      meeting = source;
+      return;
+    }
+
+    while (!forward.frontier.isEmpty() && !backward.frontier.isEmpty()) {
+      int forwardMin = forward.frontier.topKey();
+      int backwardMin = backward.frontier.topKey();
+      if (best != UNREACHABLE && forwardMin + backwardMin >= best) {
+        break;
+      }
+
+      if (forwardMin <= backwardMin) {
+        step(g, criteria, forward, backward, false);
+      } else {
+        step(g, criteria, backward, forward, true);
+      }
+    }
+  }
+
+  bool found() const { return meeting != -1; }
+
+  // Length of the shortest path, UNREACHABLE if there is none
+  int distance() const { return best; }
+
+  int settledVertices() const { return work.settled; }
+
+  // Counters of the last run
+  const SearchStats &stats() const { return work; }
+
+  // Arcs of the shortest path in travel order
+  std::vector<int> pathArcs() const {
+    std::vector<int> arcs;
+    if (!found()) {
+      return arcs;
+    }
+    for (int v = meeting; forward.next[v] != -1; v = forward.next[v]) {
+      arcs.push_back(forward.via[v]);
+    }
+    std::reverse(arcs.begin(), arcs.end());
+    for (int v = meeting; backward.next[v] != -1; v = backward.next[v]) {
+      arcs.push_back(backward.via[v]);
+    }
+    return arcs;
+  }
+};
+
+#endif
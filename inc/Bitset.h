@@ -0,0 +1,59 @@
+#ifndef BITSET_H
+#define BITSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Fixed-size set of the dense ids 0..n-1, one bit each, packed into 64-bit
+// words. Membership tests touch n / 8 bytes in total instead of a byte or a
+// hash probe per id, and whole words can be scanned to visit the ids that
+// are set (or clear) without testing them one at a time.
+class Bitset {
+  std::vector<std::uint64_t> words;
+  int n;
+
+public:
+  Bitset(int size = 0) { resize(size); }
+
+  // Sizes the set for ids 0..size-1 and empties it
+  void resize(int size) {
+    n = size;
+    words.assign((size + 63) / 64, 0);
+  }
+
+  int size() const { return n; }
+
+  void clear() { words.assign(words.size(), 0); }
+
+  void set(int i) { words[i >> 6] |= std::uint64_t(1) << (i & 63); }
+
+  void reset(int i) { words[i >> 6] &= ~(std::uint64_t(1) << (i & 63)); }
+
+  bool test(int i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+
+  // Number of ids in the set
+  int count() const {
+    int total = 0;
+    for (std::uint64_t w : words) {
+      total += __builtin_popcountll(w);
+    }
+    return total;
+  }
+
+  // Word i holds ids 64 * i .. 64 * i + 63, lowest id in the lowest bit.
+  // Bits past size() are always clear.
+  int wordCount() const { return words.size(); }
+
+  std::uint64_t word(int i) const { return words[i]; }
+
+  void swap(Bitset &other) {
+    words.swap(other.words);
+    std::swap(n, other.n);
+  }
+
+  std::size_t bytes() const { return words.capacity() * sizeof(std::uint64_t); }
+};
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef BUCKET_QUEUE_H
+#define BUCKET_QUEUE_H
+
+#include <stdexcept>
+#include <vector>
+
+// Monotone min-priority queue over the dense ids 0..n-1 with integer keys
+// (Dial's circular buckets), a drop-in for IndexedHeap<int> in searches
+// whose keys never fall below the last key popped (or the first key pushed
+// after clear()) and never run more than spread ahead of it, as in Dijkstra
+// with arc weights of at most spread.
+// Keys in the window [cursor, cursor + spread] each get their own bucket of
+// a ring of spread + 1, kept as an intrusive doubly linked list so push and
+// decrease-key are O(1). Finding the front scans forward to the next
+// non-empty bucket; the cursor only moves forward, so each bucket is passed
+// over at most once per unit of key range and pops are amortised O(1) for
+// small spreads.
+class BucketQueue {
+  std::vector<int> head; // first id of each bucket, -1 if empty
+  std::vector<int> next; // next id in the same bucket, -1 at the end
+  std::vector<int> prev; // previous id in the bucket, -1 at the front,
+                         // -2 when the id is not queued
+  std::vector<int> keys;
+  int count;
+  // Lower bound on the queued keys: the last key popped, moved up to the
+  // smallest queued key when the front is looked up
+  mutable int cursor;
+  bool fresh; // nothing pushed since clear(), so any first key is fine
+
+  int slot(int key) const { return key % (int)head.size(); }
+
+  void link(int id) {
+    int &first = head[slot(keys[id])];
+    prev[id] = -1;
+    next[id] = first;
+    if (first != -1) {
+      prev[first] = id;
+    }
+    first = id;
+  }
+
+  void unlink(int id) {
+    if (prev[id] == -1) {
+      head[slot(keys[id])] = next[id];
+    } else {
+      next[prev[id]] = next[id];
+    }
+    if (next[id] != -1) {
+      prev[next[id]] = prev[id];
+    }
+    prev[id] = -2;
+  }
+
+  void checkWindow(int key) const {
+    if (key < cursor || key - cursor >= (int)head.size()) {
+      throw std::logic_error("Key outside the bucket queue's window");
+    }
+  }
+
+public:
+  BucketQueue(int n = 0, int spread = 1) {
+    count = 0;
+    cursor = 0;
+    fresh = true;
+    setSpread(spread);
+    resize(n);
+  }
+
+  // Makes room for ids 0..n-1. The queue must be empty.
+  void resize(int n) {
+    if (count > 0) {
+      throw std::logic_error("Cannot resize a non-empty bucket queue");
+    }
+    next.assign(n, -1);
+    prev.assign(n, -2);
+    keys.resize(n);
+  }
+
+  // Sets the largest gap allowed between queued keys. The queue must be
+  // empty.
+  void setSpread(int spread) {
+    if (count > 0) {
+      throw std::logic_error("Cannot change the spread of a non-empty queue");
+    }
+    head.assign(spread + 1, -1);
+  }
+
+  int spread() const { return head.size() - 1; }
+
+  int capacity() const { return prev.size(); }
+
+  int size() const { return count; }
+
+  // Storage held by the queue, including spare capacity
+  std::size_t bytes() const {
+    return (head.capacity() + next.capacity() + prev.capacity() +
+            keys.capacity()) *
+           sizeof(int);
+  }
+
+  bool isEmpty() const { return count == 0; }
+
+  bool contains(int id) const { return prev[id] != -2; }
+
+  const int &key(int id) const { return keys[id]; }
+
+  void push(int id, int key) {
+    if (contains(id)) {
+      throw std::logic_error("Id is already in the queue");
+    }
+    if (fresh) {
+      cursor = key;
+      fresh = false;
+    }
+    checkWindow(key);
+    keys[id] = key;
+    link(id);
+    count++;
+  }
+
+  void decreaseKey(int id, int key) {
+    if (!contains(id)) {
+      throw std::logic_error("Id is not in the queue");
+    }
+    checkWindow(key);
+    unlink(id);
+    keys[id] = key;
+    link(id);
+  }
+
+  // Inserts id, or lowers its key if it is already queued with a larger one.
+  // Returns false when the queue already held an equal or better key.
+  bool pushOrDecrease(int id, int key) {
+    if (!contains(id)) {
+      push(id, key);
+      return true;
+    }
+    if (key < keys[id]) {
+      decreaseKey(id, key);
+      return true;
+    }
+    return false;
+  }
+
+  int top() const {
+    if (count == 0) {
+      throw std::logic_error("Queue is empty");
+    }
+    while (head[slot(cursor)] == -1) {
+      cursor++;
+    }
+    return head[slot(cursor)];
+  }
+
+  const int &topKey() const { return keys[top()]; }
+
+  int pop() {
+    int id = top();
+    unlink(id);
+    count--;
+    return id;
+  }
+
+  // Empties the queue in O(size + spread), leaving the id range untouched.
+  void clear() {
+    for (int &first : head) {
+      for (int id = first; id != -1;) {
+        int following = next[id];
+        prev[id] = -2;
+        id = following;
+      }
+      first = -1;
+    }
+    count = 0;
+    fresh = true;
+  }
+};
+
+#endif
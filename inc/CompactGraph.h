@@ -0,0 +1,223 @@
+#ifndef COMPACT_GRAPH_H
+#define COMPACT_GRAPH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+enum SearchCriteria { CHEAPEST, FASTEST, LEAST_STOPS };
+
+// Read-only snapshot of a Graph in compressed-sparse-row form.
+// Vertices are the dense ids 0..n-1 and the arcs leaving u occupy the index
+// range [offsets[u], offsets[u + 1]) of the parallel target/cost/duration
+// arrays, in the same order as u's edgeList. An arc is 12 bytes and the
+// arcs of a vertex are contiguous, so relaxing them touches one cache line
+// instead of chasing an Edge pointer per neighbour.
+// The reverse index lists the arcs entering each vertex the same way, as
+// (source, forward arc id) pairs, for searches that run backward.
+struct CompactGraph {
+  std::vector<int> offsets;
+  std::vector<int> targets;
+  std::vector<int> costs;
+  std::vector<int> durations;
+
+  std::vector<int> inOffsets;
+  std::vector<int> sources;
+  std::vector<int> inArcs;
+
+  // Map coordinates of each vertex
+  std::vector<int> xs;
+  std::vector<int> ys;
+
+  // Lowest cost, duration and stop count per unit of map distance over all
+  // arcs. Any path is at least this ratio times its straight-line length,
+  // which makes the scaled distance an admissible A* heuristic.
+  double costPerUnit;
+  double timePerUnit;
+  double stopsPerUnit;
+
+  // Largest arc cost and duration, kept up to date by addArc
+  int maxCost;
+  int maxDuration;
+
+  // Graph::version this snapshot was taken at, -1 if never built
+  long version;
+
+  CompactGraph() {
+    offsets.push_back(0);
+    costPerUnit = HUGE_VAL;
+    timePerUnit = HUGE_VAL;
+    stopsPerUnit = HUGE_VAL;
+    maxCost = 0;
+    maxDuration = 0;
+    version = -1;
+  }
+
+  int vertexCount() const { return offsets.size() - 1; }
+
+  int arcCount() const { return targets.size(); }
+
+  int begin(int u) const { return offsets[u]; }
+
+  int end(int u) const { return offsets[u + 1]; }
+
+  int degree(int u) const { return offsets[u + 1] - offsets[u]; }
+
+  // Vertex the arc leaves
+  int tail(int arc) const {
+    return std::upper_bound(offsets.begin(), offsets.end(), arc) -
+           offsets.begin() - 1;
+  }
+
+  // Range of v's entries in the reverse index, valid after buildReverse()
+  int inBegin(int v) const { return inOffsets[v]; }
+
+  int inEnd(int v) const { return inOffsets[v + 1]; }
+
+  // The quantity an arc contributes to the path cost under criteria
+  int weight(int arc, SearchCriteria criteria) const {
+    if (criteria == CHEAPEST) {
+      return costs[arc];
+    } else if (criteria == FASTEST) {
+      return durations[arc];
+    }
+    return 1;
+  }
+
+  // Largest weight of any arc under criteria, 0 without arcs
+  int maxWeight(SearchCriteria criteria) const {
+    if (criteria == CHEAPEST) {
+      return maxCost;
+    } else if (criteria == FASTEST) {
+      return maxDuration;
+    }
+    return arcCount() > 0 ? 1 : 0;
+  }
+
+  // Straight-line map distance between two vertices
+  double distance(int u, int v) const {
+    double dx = xs[u] - xs[v];
+    double dy = ys[u] - ys[v];
+    return std::sqrt(dx * dx + dy * dy);
+  }
+
+  // Per-unit-distance lower bound on the path cost under criteria
+  double perUnit(SearchCriteria criteria) const {
+    double ratio = criteria == CHEAPEST  ? costPerUnit
+                   : criteria == FASTEST ? timePerUnit
+                                         : stopsPerUnit;
+    // No arc has any length, so distance says nothing about cost
+    return std::isinf(ratio) ? 0 : ratio;
+  }
+
+  void addVertex(int x = 0, int y = 0) {
+    offsets.push_back(offsets.back());
+    xs.push_back(x);
+    ys.push_back(y);
+  }
+
+  // Appends an arc leaving the most recently added vertex
+  void addArc(int to, int cost, int duration) {
+    targets.push_back(to);
+    costs.push_back(cost);
+    durations.push_back(duration);
+    offsets.back()++;
+    maxCost = std::max(maxCost, cost);
+    maxDuration = std::max(maxDuration, duration);
+  }
+
+  // Changes an arc's cost and duration in place. The reverse index still
+  // holds; the maxima and per-unit ratios are rescanned only when the arc
+  // may have defined them.
+  void setArc(int arc, int cost, int duration) {
+    double length = distance(tail(arc), targets[arc]);
+    bool rescan = costs[arc] == maxCost || durations[arc] == maxDuration ||
+                  (length > 0 && (costs[arc] / length == costPerUnit ||
+                                  durations[arc] / length == timePerUnit));
+    costs[arc] = cost;
+    durations[arc] = duration;
+    if (rescan) {
+      maxCost = 0;
+      maxDuration = 0;
+      for (int a = 0; a < arcCount(); a++) {
+        maxCost = std::max(maxCost, costs[a]);
+        maxDuration = std::max(maxDuration, durations[a]);
+      }
+      computeBounds();
+      return;
+    }
+    maxCost = std::max(maxCost, cost);
+    maxDuration = std::max(maxDuration, duration);
+    if (length > 0) {
+      costPerUnit = std::min(costPerUnit, cost / length);
+      timePerUnit = std::min(timePerUnit, duration / length);
+    }
+  }
+
+  // Fills the reverse index by counting sort on the arc targets
+  void buildReverse() {
+    int n = vertexCount();
+    inOffsets.assign(n + 1, 0);
+    for (int arc = 0; arc < arcCount(); arc++) {
+      inOffsets[targets[arc] + 1]++;
+    }
+    for (int v = 0; v < n; v++) {
+      inOffsets[v + 1] += inOffsets[v];
+    }
+
+    std::vector<int> fill(inOffsets.begin(), inOffsets.end() - 1);
+    sources.assign(arcCount(), 0);
+    inArcs.assign(arcCount(), 0);
+    for (int u = 0; u < n; u++) {
+      for (int arc = begin(u); arc < end(u); arc++) {
+        int slot = fill[targets[arc]]++;
+        sources[slot] = u;
+        inArcs[slot] = arc;
+      }
+    }
+  }
+
+  // The same vertices with every arc turned around, for one-to-all searches
+  // toward a vertex. Needs the reverse index.
+  CompactGraph reversed() const {
+    CompactGraph r;
+    for (int v = 0; v < vertexCount(); v++) {
+      r.addVertex(xs[v], ys[v]);
+      for (int i = inBegin(v); i < inEnd(v); i++) {
+        r.addArc(sources[i], costs[inArcs[i]], durations[inArcs[i]]);
+      }
+    }
+    r.buildReverse();
+    r.computeBounds();
+    r.version = version;
+    return r;
+  }
+
+  // Derives the per-unit ratios from the arcs, once all vertices are placed
+  void computeBounds() {
+    costPerUnit = HUGE_VAL;
+    timePerUnit = HUGE_VAL;
+    stopsPerUnit = HUGE_VAL;
+    for (int u = 0; u < vertexCount(); u++) {
+      for (int arc = begin(u); arc < end(u); arc++) {
+        double length = distance(u, targets[arc]);
+        if (length > 0) {
+          costPerUnit = std::min(costPerUnit, costs[arc] / length);
+          timePerUnit = std::min(timePerUnit, durations[arc] / length);
+          stopsPerUnit = std::min(stopsPerUnit, 1 / length);
+        }
+      }
+    }
+  }
+
+  // Bytes held by the adjacency arrays
+  std::size_t bytes() const {
+    return (offsets.size() + targets.size() + costs.size() +
+            durations.size() + inOffsets.size() + sources.size() +
+            inArcs.size() + xs.size() + ys.size()) *
+           sizeof(int);
+  }
+};
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef CONNECTION_SCAN_H
+#define CONNECTION_SCAN_H
+
+#include <Dijkstra.h>
+#include <SearchStats.h>
+#include <Timetable.h>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+// Earliest-arrival queries on a Timetable by the Connection Scan Algorithm
+// (Dibbelt, Pajor, Strasser & Wagner). Connections are visited once each in
+// departure order, starting at the query's departure time: a connection is
+// usable if the traveller is already aboard its trip, or is at its station
+// early enough to make the layover, and a usable connection may improve the
+// arrival time at its destination. There is no queue at all, just one
+// forward pass over a contiguous array, which ends as soon as connections
+// leave after the best arrival at the target.
+// Per-station and per-trip arrays are tagged with the query that last wrote
+// them, as in Dijkstra, so starting a query is O(1).
+class ConnectionScan {
+  std::vector<int> arrival;    // earliest arrival at each station
+  std::vector<int> alight;     // connection that arrived there
+  std::vector<int> boardedAt;  // where the trip of that connection was boarded
+  std::vector<int> boarded;    // first usable connection of each trip
+  std::vector<unsigned> reachedIn;
+  std::vector<unsigned> boardedIn;
+  unsigned query;
+  int origin;
+  SearchStats work;
+
+  void prepare(const Timetable &tt) {
+    if ((int)arrival.size() != tt.stationCount() ||
+        (int)boarded.size() < tt.tripCount()) {
+      arrival.assign(tt.stationCount(), UNREACHABLE);
+      alight.assign(tt.stationCount(), -1);
+      boardedAt.assign(tt.stationCount(), -1);
+      reachedIn.assign(tt.stationCount(), 0);
+      boarded.assign(tt.tripCount(), -1);
+      boardedIn.assign(tt.tripCount(), 0);
+      query = 0;
+    }
+    query++;
+    work.clear();
+  }
+
+public:
+  ConnectionScan() {
+    query = 0;
+    origin = -1;
+  }
+
+  // Finds the earliest arrival at every station, or at target only when it
+  // is not -1, for a traveller at source from time departure on
+  void run(const Timetable &tt, int source, int departure, int target = -1) {
+    if (!tt.isSorted()) {
+      throw std::logic_error("Timetable must be sorted before scanning");
+    }
+    prepare(tt);
+    origin = source;
+    arrival[source] = departure;
+    alight[source] = -1;
+    reachedIn[source] = query;
+    work.settled++;
+
+    for (int i = tt.firstDeparting(departure); i < tt.connectionCount(); i++) {
+      const Connection &c = tt[i];
+      if (target != -1 && reached(target) && c.departure >= arrival[target]) {
+        break;
+      }
+      work.relaxed++;
+
+      bool aboard = boardedIn[c.trip] == query;
+      if (!aboard) {
+        if (!reached(c.from)) {
+          continue;
+        }
+        int ready = arrival[c.from];
+        if (c.from != source) {
+          ready += tt.layover(c.from);
+        }
+        if (ready > c.departure) {
+          continue;
+        }
+        boarded[c.trip] = i;
+        boardedIn[c.trip] = query;
+      }
+
+      if (!reached(c.to) || c.arrival < arrival[c.to]) {
+        if (!reached(c.to)) {
+          work.settled++;
+        }
+        arrival[c.to] = c.arrival;
+        alight[c.to] = i;
+        boardedAt[c.to] = boarded[c.trip];
+        reachedIn[c.to] = query;
+      }
+    }
+
+    work.bytes = tt.bytes() + 4 * arrival.size() * sizeof(int) +
+                 2 * boarded.size() * sizeof(int);
+  }
+
+  bool reached(int v) const { return reachedIn[v] == query; }
+
+  // Earliest arrival at v, UNREACHABLE if it cannot be reached
+  int arrivalTime(int v) const {
+    return reached(v) ? arrival[v] : UNREACHABLE;
+  }
+
+  // Connections ridden from the source to v, in travel order, including
+  // the intermediate legs of through trips
+  std::vector<int> journey(const Timetable &tt, int v) const {
+    std::vector<int> legs;
+    if (!reached(v)) {
+      return legs;
+    }
+    while (v != origin) {
+      int last = alight[v];
+      int first = boardedAt[v];
+      int trip = tt[last].trip;
+      for (int i = last; i >= first; i--) {
+        if (tt[i].trip == trip) {
+          legs.push_back(i);
+        }
+      }
+      v = tt[first].from;
+    }
+    std::reverse(legs.begin(), legs.end());
+    return legs;
+  }
+
+  // Counters of the last run; relaxed counts connections scanned
+  const SearchStats &stats() const { return work; }
+};
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef CONSTRAINED_SEARCH_H
+#define CONSTRAINED_SEARCH_H
+
+#include <CompactGraph.h>
+#include <Dijkstra.h>
+#include <SearchStats.h>
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+// Resource-constrained shortest path: the path minimising one criteria
+// whose total under a second criteria stays within a budget, such as the
+// fastest itinerary costing at most $800.
+// Two one-to-all Dijkstras toward the target over the reverse arcs give,
+// for every vertex, the least of each criteria still needed to reach the
+// target. A label whose spent resource plus the least still needed exceeds
+// the budget can never finish and is dropped, and labels are queued by
+// their objective plus its lower bound, as in A*, so the first label to
+// reach the target is optimal. Each vertex keeps a bag of non-dominated
+// (objective, resource) labels; a label beaten on both by one in its bag
+// is dropped too.
+class ConstrainedSearch {
+public:
+  struct Label {
+    int objective;
+    int resource;
+    int vertex;
+    int parent; // label this one extends, -1 at the source
+    int arc;    // arc taken from the parent's vertex
+    bool dead;  // removed from its bag by a dominating label
+  };
+
+private:
+  struct BagEntry {
+    int objective;
+    int resource;
+    int label;
+  };
+
+  struct QueueEntry {
+    int key; // objective plus its lower bound to the target
+    int resource;
+    int label;
+
+    bool operator>(const QueueEntry &other) const {
+      if (key != other.key) {
+        return key > other.key;
+      }
+      if (resource != other.resource) {
+        return resource > other.resource;
+      }
+      return label > other.label;
+    }
+  };
+
+  CompactGraph reverse;
+  Dijkstra toTarget;
+  std::vector<int> objectiveBound;
+  std::vector<int> resourceBound;
+  std::vector<Label> labels;
+  std::vector<std::vector<BagEntry>> bags;
+  std::vector<int> touched;
+  int found;
+  SearchStats work;
+
+  // Least of criteria needed from every vertex to target
+  void bound(const CompactGraph &g, int target, SearchCriteria criteria,
+             std::vector<int> &out) {
+    toTarget.run(reverse, target, -1, criteria);
+    out.resize(g.vertexCount());
+    for (int v = 0; v < g.vertexCount(); v++) {
+      out[v] = toTarget.distance(v);
+    }
+  }
+
+  // Adds a label to v's bag unless the bag dominates it, evicting the
+  // entries it dominates; false if it was dominated
+  bool insert(int v, int label) {
+    const Label &l = labels[label];
+    std::vector<BagEntry> &bag = bags[v];
+    for (const BagEntry &e : bag) {
+      if (e.objective <= l.objective && e.resource <= l.resource) {
+        return false;
+      }
+    }
+    if (bag.empty()) {
+      touched.push_back(v);
+    }
+
+    int kept = 0;
+    for (std::size_t i = 0; i < bag.size(); i++) {
+      const BagEntry &e = bag[i];
+      if (l.objective <= e.objective && l.resource <= e.resource) {
+        labels[e.label].dead = true;
+      } else {
+        bag[kept++] = e;
+      }
+    }
+    bag.resize(kept);
+    bag.push_back(BagEntry{l.objective, l.resource, label});
+    return true;
+  }
+
+public:
+  ConstrainedSearch() { found = -1; }
+
+  // Finds the source-target path minimising objective among those whose
+  // total under limited is at most budget. g must have its reverse index.
+  void run(const CompactGraph &g, int source, int target,
+           SearchCriteria objective, SearchCriteria limited, int budget) {
+    if (objective == limited) {
+      throw std::logic_error("Cannot budget the criteria being minimised");
+    }
+    for (int v : touched) {
+      bags[v].clear();
+    }
+    touched.clear();
+    labels.clear();
+    found = -1;
+    work.clear();
+    if ((int)bags.size() != g.vertexCount()) {
+      bags.assign(g.vertexCount(), std::vector<BagEntry>());
+    }
+    if (reverse.version != g.version || g.version == -1 ||
+        reverse.vertexCount() != g.vertexCount() ||
+        reverse.arcCount() != g.arcCount()) {
+      reverse = g.reversed();
+    }
+
+    bound(g, target, limited, resourceBound);
+    bound(g, target, objective, objectiveBound);
+    if (resourceBound[source] == UNREACHABLE ||
+        resourceBound[source] > budget) {
+      return;
+    }
+
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+                        std::greater<QueueEntry>>
+        queue;
+    labels.push_back(Label{0, 0, source, -1, -1, false});
+    insert(source, 0);
+    queue.push(QueueEntry{objectiveBound[source], 0, 0});
+    work.pushed(1);
+
+    while (!queue.empty()) {
+      QueueEntry top = queue.top();
+      queue.pop();
+      work.pops++;
+      if (labels[top.label].dead) {
+        continue;
+      }
+      work.settled++;
+
+      Label current = labels[top.label];
+      if (current.vertex == target) {
+        found = top.label;
+        break;
+      }
+
+      int u = current.vertex;
+      for (int arc = g.begin(u); arc < g.end(u); arc++) {
+        int v = g.targets[arc];
+        work.relaxed++;
+        if (resourceBound[v] == UNREACHABLE) {
+          continue;
+        }
+        int o = current.objective + g.weight(arc, objective);
+        int r = current.resource + g.weight(arc, limited);
+        if (r + resourceBound[v] > budget) {
+          continue;
+        }
+
+        labels.push_back(Label{o, r, v, top.label, arc, false});
+        int label = labels.size() - 1;
+        if (!insert(v, label)) {
+          labels.pop_back();
+          continue;
+        }
+        queue.push(QueueEntry{o + objectiveBound[v], r, label});
+        work.pushed(queue.size());
+      }
+    }
+
+    work.bytes = labels.capacity() * sizeof(Label) +
+                 work.peakFrontier * sizeof(QueueEntry) + reverse.bytes() +
+                 toTarget.stats().bytes + 2 * g.vertexCount() * sizeof(int);
+    for (int v : touched) {
+      work.bytes += bags[v].capacity() * sizeof(BagEntry);
+    }
+  }
+
+  bool foundPath() const { return found != -1; }
+
+  // Objective and resource totals of the path found
+  int objective() const {
+    return found == -1 ? UNREACHABLE : labels[found].objective;
+  }
+
+  int resource() const {
+    return found == -1 ? UNREACHABLE : labels[found].resource;
+  }
+
+  // Arcs of the path found, in travel order
+  std::vector<int> pathArcs() const {
+    std::vector<int> arcs;
+    for (int l = found; l != -1 && labels[l].parent != -1;
+         l = labels[l].parent) {
+      arcs.push_back(labels[l].arc);
+    }
+    std::reverse(arcs.begin(), arcs.end());
+    return arcs;
+  }
+
+  // Labels created by the last run
+  int labelCount() const { return labels.size(); }
+
+  // Counters of the label search of the last run; settled counts labels
+  // made final, and bytes includes the reverse graph and bound searches
+  const SearchStats &stats() const { return work; }
+};
+
+#endif
@@ -0,0 +1,424 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include <CompactGraph.h>
+#include <Dijkstra.h>
+#include <IndexedHeap.h>
+#include <SearchStats.h>
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// Contraction Hierarchies for one SearchCriteria over a frozen graph.
+// Preprocessing contracts the vertices one at a time in order of edge
+// difference: a vertex is removed and a shortcut u -> x is added for every
+// path u -> v -> x that a local witness search cannot match without v.
+// Every shortest path then climbs to its highest-ranked vertex and descends
+// again, so a query is two small upward searches that meet at the top.
+// Shortcuts remember the vertex they bypass (and the two arcs they replace)
+// so a query result unpacks back into arcs of the CompactGraph.
+class ContractionHierarchy {
+  struct Arc {
+    int from;
+    int to;
+    int weight;
+    int middle;   // bypassed vertex, -1 for an original arc
+    int first;    // shortcut halves from -> middle and middle -> to
+    int second;
+    int original; // CompactGraph arc id, -1 for a shortcut
+  };
+
+  struct Side {
+    std::vector<int> dist;
+    std::vector<int> via;
+    std::vector<unsigned> reachedIn;
+    IndexedHeap<int> frontier;
+  };
+
+  SearchCriteria criteria;
+  std::vector<Arc> arcs;
+  std::vector<int> rankOf;
+  int shortcuts;
+
+  // Arcs toward higher ranks, listed at their tail (forward search) and at
+  // their head (backward search)
+  std::vector<int> upOffsets;
+  std::vector<int> upArcs;
+  std::vector<int> downOffsets;
+  std::vector<int> downArcs;
+
+  Side forward;
+  Side backward;
+  unsigned query;
+  int best;
+  int meeting;
+  SearchStats work;
+
+  // Preprocessing state, released once the hierarchy is built
+  std::vector<std::vector<int>> out;
+  std::vector<std::vector<int>> in;
+  std::vector<bool> contracted;
+  std::vector<int> deletedNeighbors;
+  std::vector<int> witnessDist;
+  std::vector<unsigned> witnessStamp;
+  unsigned witnessQuery;
+
+  static const int WITNESS_SETTLE_LIMIT = 500;
+
+  // Local Dijkstra from source that ignores avoid and contracted vertices
+  // and gives up beyond limit, filling witnessDist for the targets it meets
+  void witness(int source, int avoid, int limit) {
+    typedef std::pair<int, int> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    witnessQuery++;
+    witnessDist[source] = 0;
+    witnessStamp[source] = witnessQuery;
+    queue.push(Entry(0, source));
+
+    int settled = 0;
+    while (!queue.empty() && settled < WITNESS_SETTLE_LIMIT) {
+      Entry top = queue.top();
+      queue.pop();
+      int u = top.second;
+      if (top.first > witnessDist[u]) {
+        continue;
+      }
+      if (top.first > limit) {
+        break;
+      }
+      settled++;
+
+      for (int e : out[u]) {
+        int x = arcs[e].to;
+        if (x == avoid || contracted[x]) {
+          continue;
+        }
+        int candidate = top.first + arcs[e].weight;
+        if (witnessStamp[x] != witnessQuery || candidate < witnessDist[x]) {
+          witnessDist[x] = candidate;
+          witnessStamp[x] = witnessQuery;
+          queue.push(Entry(candidate, x));
+        }
+      }
+    }
+  }
+
+  int witnessDistance(int x) const {
+    return witnessStamp[x] == witnessQuery ? witnessDist[x] : UNREACHABLE;
+  }
+
+  void addShortcut(int u, int x, int weight, int middle, int first,
+                   int second) {
+    for (int e : out[u]) {
+      if (arcs[e].to == x) {
+        if (arcs[e].weight > weight) {
+          arcs[e] = Arc{u, x, weight, middle, first, second, -1};
+        }
+        return;
+      }
+    }
+    arcs.push_back(Arc{u, x, weight, middle, first, second, -1});
+    out[u].push_back(arcs.size() - 1);
+    in[x].push_back(arcs.size() - 1);
+    shortcuts++;
+  }
+
+  // Removes v from the remaining graph, or with simulate only counts the
+  // shortcuts that would take its place
+  int contract(int v, bool simulate) {
+    int needed = 0;
+    for (int e1 : in[v]) {
+      int u = arcs[e1].from;
+      if (contracted[u]) {
+        continue;
+      }
+
+      int limit = -1;
+      for (int e2 : out[v]) {
+        int x = arcs[e2].to;
+        if (x != u && !contracted[x]) {
+          limit = std::max(limit, arcs[e1].weight + arcs[e2].weight);
+        }
+      }
+      if (limit < 0) {
+        continue;
+      }
+
+      witness(u, v, limit);
+      for (int e2 : out[v]) {
+        int x = arcs[e2].to;
+        if (x == u || contracted[x]) {
+          continue;
+        }
+        int through = arcs[e1].weight + arcs[e2].weight;
+        if (witnessDistance(x) <= through) {
+          continue;
+        }
+        needed++;
+        if (!simulate) {
+          addShortcut(u, x, through, v, e1, e2);
+        }
+      }
+    }
+    return needed;
+  }
+
+  // Edge difference plus the number of already contracted neighbours,
+  // which spreads contraction evenly across the graph
+  int priority(int v) {
+    int removed = 0;
+    for (int e : in[v]) {
+      removed += contracted[arcs[e].from] ? 0 : 1;
+    }
+    for (int e : out[v]) {
+      removed += contracted[arcs[e].to] ? 0 : 1;
+    }
+    return contract(v, true) - removed + deletedNeighbors[v];
+  }
+
+  void build(const CompactGraph &g) {
+    int n = g.vertexCount();
+    out.assign(n, std::vector<int>());
+    in.assign(n, std::vector<int>());
+    contracted.assign(n, false);
+    deletedNeighbors.assign(n, 0);
+    witnessDist.assign(n, UNREACHABLE);
+    witnessStamp.assign(n, 0);
+    witnessQuery = 0;
+
+    // Original arcs, keeping only the lightest of any parallel arcs
+    std::vector<int> lastTail(n, -1);
+    std::vector<int> slot(n, -1);
+    for (int u = 0; u < n; u++) {
+      for (int arc = g.begin(u); arc < g.end(u); arc++) {
+        int v = g.targets[arc];
+        int w = g.weight(arc, criteria);
+        if (v == u) {
+          continue;
+        }
+        if (lastTail[v] == u) {
+          if (w < arcs[slot[v]].weight) {
+            arcs[slot[v]].weight = w;
+            arcs[slot[v]].original = arc;
+          }
+          continue;
+        }
+        lastTail[v] = u;
+        slot[v] = arcs.size();
+        arcs.push_back(Arc{u, v, w, -1, -1, -1, arc});
+        out[u].push_back(slot[v]);
+        in[v].push_back(slot[v]);
+      }
+    }
+
+    // Contract in priority order, re-evaluating lazily on pop
+    IndexedHeap<int> order(n);
+    for (int v = 0; v < n; v++) {
+      order.push(v, priority(v));
+    }
+    rankOf.assign(n, 0);
+    int rank = 0;
+    while (!order.isEmpty()) {
+      int v = order.pop();
+      int current = priority(v);
+      if (!order.isEmpty() && current > order.topKey()) {
+        order.push(v, current);
+        continue;
+      }
+
+      contract(v, false);
+      contracted[v] = true;
+      rankOf[v] = rank++;
+      for (int e : in[v]) {
+        deletedNeighbors[arcs[e].from]++;
+      }
+      for (int e : out[v]) {
+        deletedNeighbors[arcs[e].to]++;
+      }
+    }
+
+    // Split the arcs into the upward and downward search graphs
+    upOffsets.assign(n + 1, 0);
+    downOffsets.assign(n + 1, 0);
+    for (const Arc &a : arcs) {
+      if (rankOf[a.to] > rankOf[a.from]) {
+        upOffsets[a.from + 1]++;
+      } else {
+        downOffsets[a.to + 1]++;
+      }
+    }
+    for (int v = 0; v < n; v++) {
+      upOffsets[v + 1] += upOffsets[v];
+      downOffsets[v + 1] += downOffsets[v];
+    }
+    upArcs.assign(upOffsets[n], 0);
+    downArcs.assign(downOffsets[n], 0);
+    std::vector<int> upFill(upOffsets.begin(), upOffsets.end() - 1);
+    std::vector<int> downFill(downOffsets.begin(), downOffsets.end() - 1);
+    for (int e = 0; e < (int)arcs.size(); e++) {
+      if (rankOf[arcs[e].to] > rankOf[arcs[e].from]) {
+        upArcs[upFill[arcs[e].from]++] = e;
+      } else {
+        downArcs[downFill[arcs[e].to]++] = e;
+      }
+    }
+
+    out.clear();
+    in.clear();
+    contracted.clear();
+    deletedNeighbors.clear();
+    witnessDist.clear();
+    witnessStamp.clear();
+
+    for (Side *side : {&forward, &backward}) {
+      side->dist.assign(n, UNREACHABLE);
+      side->via.assign(n, -1);
+      side->reachedIn.assign(n, 0);
+      side->frontier.resize(n);
+    }
+  }
+
+  void reach(Side &side, int v, int distance, int arc) {
+    if (!side.frontier.contains(v)) {
+      work.pushed(forward.frontier.size() + backward.frontier.size() + 1);
+    } else {
+      work.decreaseKeys++;
+    }
+    side.dist[v] = distance;
+    side.via[v] = arc;
+    side.reachedIn[v] = query;
+    side.frontier.pushOrDecrease(v, distance);
+  }
+
+  // Settles the closest vertex of self and relaxes its upward arcs
+  void step(Side &self, Side &other, bool upward) {
+    int u = self.frontier.pop();
+    work.pops++;
+    work.settled++;
+
+    const std::vector<int> &offsets = upward ? upOffsets : downOffsets;
+    const std::vector<int> &list = upward ? upArcs : downArcs;
+    for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+      const Arc &a = arcs[list[i]];
+      int v = upward ? a.to : a.from;
+      work.relaxed++;
+      int candidate = self.dist[u] + a.weight;
+      if (self.reachedIn[v] != query || candidate < self.dist[v]) {
+        reach(self, v, candidate, list[i]);
+        if (other.reachedIn[v] == query &&
+            candidate + other.dist[v] < best) {
+          best = candidate + other.dist[v];
+          meeting = v;
+        }
+      }
+    }
+  }
+
+  // Appends the CompactGraph arcs behind hierarchy arc e, in travel order
+  void unpack(int e, std::vector<int> &path) const {
+    std::vector<int> stack(1, e);
+    while (!stack.empty()) {
+      const Arc &a = arcs[stack.back()];
+      stack.pop_back();
+      if (a.original != -1) {
+        path.push_back(a.original);
+      } else {
+        stack.push_back(a.second);
+        stack.push_back(a.first);
+      }
+    }
+  }
+
+public:
+  // Graph::version of the snapshot the hierarchy was built from
+  long version;
+
+  ContractionHierarchy(const CompactGraph &g, SearchCriteria criteria) {
+    this->criteria = criteria;
+    this->version = g.version;
+    shortcuts = 0;
+    query = 0;
+    best = UNREACHABLE;
+    meeting = -1;
+    build(g);
+  }
+
+  SearchCriteria getCriteria() const { return criteria; }
+
+  int shortcutCount() const { return shortcuts; }
+
+  // Position of v in the contraction order, 0 contracted first
+  int rank(int v) const { return rankOf[v]; }
+
+  // Runs the upward searches from source and target and returns the
+  // shortest path length, UNREACHABLE if there is none
+  int distance(int source, int target) {
+    query++;
+    best = UNREACHABLE;
+    meeting = -1;
+    work.clear();
+    work.bytes = forward.frontier.bytes() + backward.frontier.bytes() +
+                 6 * forward.dist.size() * sizeof(int);
+    forward.frontier.clear();
+    backward.frontier.clear();
+
+    reach(forward, source, 0, -1);
+    reach(backward, target, 0, -1);
+    if (source == target) {
+      best = 0;
+      meeting = source;
+    }
+
+    // Neither side can stop at the first meeting: the best path meets at
+    // its highest vertex, so each side runs until it cannot beat best
+    while (true) {
+      bool forwardOpen = !forward.frontier.isEmpty() &&
+                         forward.frontier.topKey() < best;
+      bool backwardOpen = !backward.frontier.isEmpty() &&
+                          backward.frontier.topKey() < best;
+      if (!forwardOpen && !backwardOpen) {
+        break;
+      }
+      if (forwardOpen && (!backwardOpen || forward.frontier.topKey() <=
+                                               backward.frontier.topKey())) {
+        step(forward, backward, true);
+      } else {
+        step(backward, forward, false);
+      }
+    }
+    return best;
+  }
+
+  // Vertices settled by the last query
+  int settledVertices() const { return work.settled; }
+
+  // Counters of the last query
+  const SearchStats &stats() const { return work; }
+
+  // Shortest path as CompactGraph arcs in travel order, empty when the
+  // target is unreachable or equal to the source
+  std::vector<int> pathArcs(int source, int target) {
+    std::vector<int> path;
+    if (distance(source, target) == UNREACHABLE) {
+      return path;
+    }
+
+    std::vector<int> up;
+    for (int v = meeting; forward.via[v] != -1;) {
+      up.push_back(forward.via[v]);
+      v = arcs[forward.via[v]].from;
+    }
+    for (int i = up.size() - 1; i >= 0; i--) {
+      unpack(up[i], path);
+    }
+    for (int v = meeting; backward.via[v] != -1;) {
+      unpack(backward.via[v], path);
+      v = arcs[backward.via[v]].to;
+    }
+    return path;
+  }
+};
+
+#endif
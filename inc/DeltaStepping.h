@@ -0,0 +1,261 @@
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include <CompactGraph.h>
+#include <Dijkstra.h>
+#include <Parallel.h>
+#include <SearchStats.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+// Parallel one-to-all shortest paths by delta-stepping (Meyer & Sanders).
+// Tentative distances are grouped into buckets of width delta. The lowest
+// bucket is emptied in phases: all of its vertices relax their light arcs
+// (weight <= delta) at once, which may refill the same bucket, and once it
+// stays empty the vertices it held relax their heavy arcs, which can only
+// reach later buckets. Each phase's vertices are split among workers that
+// lower distances with an atomic minimum, so the distances come out the
+// same as Dijkstra's whatever the interleaving. The shortest path tree is
+// then picked by a breadth-first pass over tight arcs in arc order, which
+// makes parents deterministic too.
+// delta trades work for parallelism: 1 on unit weights is a parallel BFS,
+// while a huge delta relaxes everything at once like Bellman-Ford.
+class DeltaStepping {
+  // Phases smaller than this many vertices are not worth spreading out
+  static constexpr int GRAIN = 256;
+
+  int delta; // configured width, 0 for automatic
+  int width; // width used by the current run
+  int threads;
+  int phaseCount;
+
+  std::vector<std::atomic<int>> dist;
+  std::vector<int> parent;
+  std::vector<int> via;
+
+  // Arc ids of each vertex, light ones first, and where the heavy start
+  std::vector<int> arcOrder;
+  std::vector<int> heavyBegin;
+
+  std::vector<std::vector<int>> buckets; // ring of maxWeight / delta + 2
+  std::vector<long> queuedIn;            // last phase that took the vertex
+  std::vector<long> bucketOf;            // last bucket that settled it
+  std::vector<std::vector<int>> updated; // per worker
+  std::vector<SearchStats> workerStats;
+  SearchStats work;
+  long pending;
+
+  // Lowers dist[v] to candidate if that improves it; true if it did
+  bool lower(int v, int candidate) {
+    int current = dist[v].load(std::memory_order_relaxed);
+    while (candidate < current) {
+      if (dist[v].compare_exchange_weak(current, candidate,
+                                        std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void enqueue(int v) {
+    long b = dist[v].load(std::memory_order_relaxed) / width;
+    buckets[b % buckets.size()].push_back(v);
+    pending++;
+  }
+
+  // Splits every vertex's arcs into light and heavy under criteria
+  void classify(const CompactGraph &g, SearchCriteria criteria) {
+    int n = g.vertexCount();
+    arcOrder.resize(g.arcCount());
+    heavyBegin.resize(n);
+    for (int u = 0; u < n; u++) {
+      int next = g.begin(u);
+      for (int arc = g.begin(u); arc < g.end(u); arc++) {
+        if (g.weight(arc, criteria) <= width) {
+          arcOrder[next++] = arc;
+        }
+      }
+      heavyBegin[u] = next;
+      for (int arc = g.begin(u); arc < g.end(u); arc++) {
+        if (g.weight(arc, criteria) > width) {
+          arcOrder[next++] = arc;
+        }
+      }
+    }
+  }
+
+  // Relaxes the light (or heavy) arcs of every vertex in frontier
+  void relax(const CompactGraph &g, SearchCriteria criteria,
+             const std::vector<int> &frontier, bool heavy) {
+    int chunks = (frontier.size() + GRAIN - 1) / GRAIN;
+    parallelFor(chunks, threads, [&](int chunk, int worker) {
+      std::vector<int> &out = updated[worker];
+      SearchStats &counts = workerStats[worker];
+      int last = std::min<int>(frontier.size(), (chunk + 1) * GRAIN);
+      for (int i = chunk * GRAIN; i < last; i++) {
+        int u = frontier[i];
+        int du = dist[u].load(std::memory_order_relaxed);
+        int first = heavy ? heavyBegin[u] : g.begin(u);
+        int end = heavy ? g.end(u) : heavyBegin[u];
+        for (int k = first; k < end; k++) {
+          int arc = arcOrder[k];
+          counts.relaxed++;
+          if (lower(g.targets[arc], du + g.weight(arc, criteria))) {
+            out.push_back(g.targets[arc]);
+          }
+        }
+      }
+    });
+
+    for (std::vector<int> &out : updated) {
+      for (int v : out) {
+        enqueue(v);
+      }
+      work.pushes += out.size();
+      out.clear();
+    }
+  }
+
+  // Picks parents by a breadth-first pass over tight arcs
+  void buildTree(const CompactGraph &g, int source, SearchCriteria criteria) {
+    std::vector<int> order(1, source);
+    parent[source] = source;
+    for (std::size_t i = 0; i < order.size(); i++) {
+      int u = order[i];
+      int du = distance(u);
+      for (int arc = g.begin(u); arc < g.end(u); arc++) {
+        int v = g.targets[arc];
+        if (parent[v] == -1 && du + g.weight(arc, criteria) == distance(v)) {
+          parent[v] = u;
+          via[v] = arc;
+          order.push_back(v);
+        }
+      }
+    }
+    parent[source] = -1;
+  }
+
+public:
+  // delta of 0 picks the mean arc weight when run
+  DeltaStepping(int delta = 0, int threads = defaultThreads()) {
+    this->delta = delta;
+    this->threads = std::max(1, threads);
+    width = 1;
+    phaseCount = 0;
+    pending = 0;
+  }
+
+  void setDelta(int delta) { this->delta = delta; }
+
+  // Bucket width used by the last run
+  int bucketWidth() const { return width; }
+
+  void setThreads(int threads) { this->threads = std::max(1, threads); }
+
+  // Computes the distance from source to every vertex. Weights must not be
+  // negative.
+  void run(const CompactGraph &g, int source, SearchCriteria criteria) {
+    int n = g.vertexCount();
+    long total = 0;
+    int heaviest = 0;
+    for (int arc = 0; arc < g.arcCount(); arc++) {
+      total += g.weight(arc, criteria);
+      heaviest = std::max(heaviest, g.weight(arc, criteria));
+    }
+    width = delta;
+    if (width <= 0) {
+      width = g.arcCount() > 0 ? std::max(1L, total / g.arcCount()) : 1;
+    }
+
+    if ((int)dist.size() != n) {
+      std::vector<std::atomic<int>>(n).swap(dist);
+    }
+    for (int v = 0; v < n; v++) {
+      dist[v].store(UNREACHABLE, std::memory_order_relaxed);
+    }
+    parent.assign(n, -1);
+    via.assign(n, -1);
+    queuedIn.assign(n, -1);
+    bucketOf.assign(n, -1);
+    buckets.assign(heaviest / width + 2, std::vector<int>());
+    updated.assign(threads, std::vector<int>());
+    workerStats.assign(threads, SearchStats());
+    work.clear();
+    phaseCount = 0;
+    pending = 0;
+    classify(g, criteria);
+
+    dist[source].store(0, std::memory_order_relaxed);
+    enqueue(source);
+    work.pushes++;
+
+    std::vector<int> frontier;
+    std::vector<int> settled;
+    for (long b = 0; pending > 0; b++) {
+      std::vector<int> &bucket = buckets[b % buckets.size()];
+      settled.clear();
+      while (!bucket.empty()) {
+        // Take the bucket's live entries, each vertex once per phase
+        frontier.clear();
+        for (int v : bucket) {
+          if (dist[v].load(std::memory_order_relaxed) / width == b &&
+              queuedIn[v] != phaseCount) {
+            queuedIn[v] = phaseCount;
+            frontier.push_back(v);
+            if (bucketOf[v] != b) {
+              bucketOf[v] = b;
+              settled.push_back(v);
+            }
+          }
+        }
+        pending -= bucket.size();
+        work.pops += bucket.size();
+        bucket.clear();
+        phaseCount++;
+        work.peakFrontier = std::max<long>(work.peakFrontier, frontier.size());
+        relax(g, criteria, frontier, false);
+      }
+      relax(g, criteria, settled, true);
+      work.settled += settled.size();
+    }
+
+    buildTree(g, source, criteria);
+    for (const SearchStats &w : workerStats) {
+      work.relaxed += w.relaxed;
+    }
+    work.bytes = n * (3 * sizeof(int) + 2 * sizeof(long)) +
+                 g.arcCount() * sizeof(int) * 2;
+  }
+
+  bool reached(int v) const { return distance(v) != UNREACHABLE; }
+
+  int distance(int v) const { return dist[v].load(std::memory_order_relaxed); }
+
+  // Predecessor of v in the shortest path tree, -1 for the source
+  int parentOf(int v) const { return parent[v]; }
+
+  // Arc used to enter v in the shortest path tree, -1 for the source
+  int arcTo(int v) const { return via[v]; }
+
+  // Arcs of the path from the source to v, in travel order
+  std::vector<int> pathArcs(int v) const {
+    std::vector<int> arcs;
+    if (!reached(v)) {
+      return arcs;
+    }
+    for (int u = v; parent[u] != -1; u = parent[u]) {
+      arcs.push_back(via[u]);
+    }
+    std::reverse(arcs.begin(), arcs.end());
+    return arcs;
+  }
+
+  // Light-arc phases run by the last query
+  int phases() const { return phaseCount; }
+
+  // Counters of the last run; pushes and pops count bucket entries
+  const SearchStats &stats() const { return work; }
+};
+
+#endif
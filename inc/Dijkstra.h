@@ -0,0 +1,272 @@
+#ifndef DIJKSTRA_H
+#define DIJKSTRA_H
+
+#include <BucketQueue.h>
+#include <CompactGraph.h>
+#include <IndexedHeap.h>
+#include <SearchStats.h>
+#include <SearchTrace.h>
+#include <algorithm>
+#include <climits>
+#include <type_traits>
+#include <vector>
+
+// Distance reported for vertices the search never reached
+const int UNREACHABLE = INT_MAX;
+
+// Potential of plain Dijkstra: no estimate of the remaining cost.
+// A potential may return UNREACHABLE for vertices it knows cannot reach the
+// target, and the search then never queues them.
+struct NoPotential {
+  int operator()(int v) const { return 0; }
+};
+
+// Filter of a search that may use every arc and vertex
+struct AllowAll {
+  bool allows(int arc, int v) const { return true; }
+};
+
+// Vertices and arcs a search must not use. Marks are stamped, so clearing
+// the set between searches is O(1).
+class Blocked {
+  std::vector<unsigned> vertexMark;
+  std::vector<unsigned> arcMark;
+  unsigned stamp;
+
+public:
+  Blocked() { stamp = 0; }
+
+  // Unblocks everything and sizes the set for a graph
+  void reset(int vertices, int arcs) {
+    if ((int)vertexMark.size() != vertices || (int)arcMark.size() != arcs) {
+      vertexMark.assign(vertices, 0);
+      arcMark.assign(arcs, 0);
+    }
+    stamp++;
+  }
+
+  void blockVertex(int v) { vertexMark[v] = stamp; }
+
+  void blockArc(int arc) { arcMark[arc] = stamp; }
+
+  bool allows(int arc, int v) const {
+    return arcMark[arc] != stamp && vertexMark[v] != stamp;
+  }
+};
+
+// Goal of a search that stops once target is settled, never if it is -1
+struct SingleTarget {
+  int target;
+
+  bool operator()(int u) const { return u == target; }
+};
+
+// Largest arc weight for which Dijkstra queues vertices in a BucketQueue
+const int BUCKET_QUEUE_LIMIT = 1024;
+
+// Single-source Dijkstra over a CompactGraph.
+// The per-vertex arrays are kept between queries and tagged with the query
+// that last wrote them, so starting a query is O(1) and a query only pays
+// for the vertices it actually reaches.
+// Given a consistent potential (a lower bound on the remaining cost to the
+// target) vertices are queued by distance plus potential, which is A*.
+// A filter hides arcs and vertices from a query without touching the graph.
+// Without a potential and with small integer weights, as with LEAST_STOPS
+// or typical fares, the frontier is a BucketQueue with O(1) pops instead
+// of the indexed heap.
+class Dijkstra {
+  std::vector<int> dist;
+  std::vector<int> parent;
+  std::vector<int> via;
+  std::vector<unsigned> reachedIn;
+  std::vector<unsigned> settledIn;
+  std::vector<int> settleOrder;
+  unsigned query;
+  SearchStats work;
+  IndexedHeap<int> frontier;
+  BucketQueue buckets;
+  bool usedBuckets;
+
+  void prepare(int n) {
+    if ((int)dist.size() != n) {
+      frontier.clear();
+      buckets.clear();
+      dist.assign(n, UNREACHABLE);
+      parent.assign(n, -1);
+      via.assign(n, -1);
+      reachedIn.assign(n, 0);
+      settledIn.assign(n, 0);
+      settleOrder.assign(n, -1);
+      frontier.resize(n);
+      query = 0;
+    }
+    frontier.clear();
+    buckets.clear();
+    query++;
+    work.clear();
+  }
+
+  template <class Queue, class Goal, class Trace, class Potential,
+            class Filter>
+  void explore(Queue &queue, const CompactGraph &g, int source,
+               SearchCriteria criteria, Goal &goal, Trace &trace,
+               const Potential &potential, const Filter &filter) {
+    work.bytes = queue.bytes() + 6 * dist.size() * sizeof(int);
+
+    dist[source] = 0;
+    parent[source] = -1;
+    via[source] = -1;
+    reachedIn[source] = query;
+    queue.push(source, potential(source));
+    work.pushed(1);
+
+    while (!queue.isEmpty()) {
+      int u = queue.pop();
+      work.pops++;
+      settledIn[u] = query;
+      settleOrder[u] = work.settled++;
+
+      if (goal(u)) {
+        return;
+      }
+
+      trace.expand(u);
+
+      for (int arc = g.begin(u); arc < g.end(u); arc++) {
+        int v = g.targets[arc];
+        work.relaxed++;
+        if (settledIn[v] == query || !filter.allows(arc, v)) {
+          continue;
+        }
+
+        int candidate = dist[u] + g.weight(arc, criteria);
+        if (reachedIn[v] == query && candidate >= dist[v]) {
+          continue;
+        }
+        int estimate = potential(v);
+        if (estimate == UNREACHABLE) {
+          continue;
+        }
+
+        if (reachedIn[v] != query) {
+          trace.push(v, candidate);
+          work.pushed(queue.size() + 1);
+        } else {
+          trace.decrease(v, dist[v], candidate);
+          work.decreaseKeys++;
+        }
+
+        dist[v] = candidate;
+        parent[v] = u;
+        via[v] = arc;
+        reachedIn[v] = query;
+        queue.pushOrDecrease(v, candidate + estimate);
+      }
+    }
+  }
+
+public:
+  Dijkstra() {
+    query = 0;
+    usedBuckets = false;
+  }
+
+  // Settles vertices outward from source until goal(u) is true for the
+  // vertex u just settled, or until everything reachable is settled.
+  template <class Goal, class Trace, class Potential, class Filter>
+  void runUntil(const CompactGraph &g, int source, SearchCriteria criteria,
+                Goal &goal, Trace &trace, const Potential &potential,
+                const Filter &filter) {
+    prepare(g.vertexCount());
+
+    // Bucket keys must stay within one arc weight of the last pop, which a
+    // potential would break
+    int spread = g.maxWeight(criteria);
+    usedBuckets = std::is_same<Potential, NoPotential>::value &&
+                  spread <= BUCKET_QUEUE_LIMIT;
+    if (usedBuckets) {
+      if (buckets.capacity() != g.vertexCount() ||
+          buckets.spread() != std::max(spread, 1)) {
+        buckets.setSpread(std::max(spread, 1));
+        buckets.resize(g.vertexCount());
+      }
+      explore(buckets, g, source, criteria, goal, trace, potential, filter);
+    } else {
+      explore(frontier, g, source, criteria, goal, trace, potential, filter);
+    }
+  }
+
+  template <class Goal>
+  void runUntil(const CompactGraph &g, int source, SearchCriteria criteria,
+                Goal &goal) {
+    SilentTrace trace;
+    runUntil(g, source, criteria, goal, trace, NoPotential(), AllowAll());
+  }
+
+  // Settles vertices outward from source until target is settled, or until
+  // everything reachable is settled when target is -1.
+  template <class Trace, class Potential, class Filter>
+  void run(const CompactGraph &g, int source, int target,
+           SearchCriteria criteria, Trace &trace, const Potential &potential,
+           const Filter &filter) {
+    SingleTarget goal = {target};
+    runUntil(g, source, criteria, goal, trace, potential, filter);
+  }
+
+  template <class Trace, class Potential>
+  void run(const CompactGraph &g, int source, int target,
+           SearchCriteria criteria, Trace &trace, const Potential &potential) {
+    run(g, source, target, criteria, trace, potential, AllowAll());
+  }
+
+  template <class Trace>
+  void run(const CompactGraph &g, int source, int target,
+           SearchCriteria criteria, Trace &trace) {
+    run(g, source, target, criteria, trace, NoPotential(), AllowAll());
+  }
+
+  void run(const CompactGraph &g, int source, int target,
+           SearchCriteria criteria) {
+    SilentTrace trace;
+    run(g, source, target, criteria, trace, NoPotential(), AllowAll());
+  }
+
+  bool reached(int v) const { return reachedIn[v] == query; }
+
+  // True once distance(v) is final
+  bool settled(int v) const { return settledIn[v] == query; }
+
+  int distance(int v) const { return reached(v) ? dist[v] : UNREACHABLE; }
+
+  // Position of v in the order vertices were settled, -1 if not settled
+  int settledAt(int v) const { return settled(v) ? settleOrder[v] : -1; }
+
+  // Predecessor of v on its shortest path, -1 for the source
+  int parentOf(int v) const { return reached(v) ? parent[v] : -1; }
+
+  // Arc used to enter v on its shortest path, -1 for the source
+  int arcTo(int v) const { return reached(v) ? via[v] : -1; }
+
+  int settledVertices() const { return work.settled; }
+
+  // Counters of the last run
+  const SearchStats &stats() const { return work; }
+
+  // True if the last run queued vertices in the bucket queue
+  bool usedBucketQueue() const { return usedBuckets; }
+
+  // Arcs of the path from the source to v, in travel order
+  std::vector<int> pathArcs(int v) const {
+    std::vector<int> arcs;
+    if (!reached(v)) {
+      return arcs;
+    }
+    for (int u = v; parent[u] != -1; u = parent[u]) {
+      arcs.push_back(via[u]);
+    }
+    std::reverse(arcs.begin(), arcs.end());
+    return arcs;
+  }
+};
+
+#endif
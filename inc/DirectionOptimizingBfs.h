@@ -0,0 +1,190 @@
+#ifndef DIRECTION_OPTIMIZING_BFS_H
+#define DIRECTION_OPTIMIZING_BFS_H
+
+#include <Bitset.h>
+#include <CompactGraph.h>
+#include <Dijkstra.h>
+#include <SearchStats.h>
+#include <algorithm>
+#include <vector>
+
+// Level-synchronous breadth-first search for fewest-stops routes (Beamer,
+// Asanovic & Patterson). Each level is expanded either top-down, where the
+// frontier's arcs claim their unvisited targets, or bottom-up, where every
+// unvisited vertex scans its entering arcs (the reverse index) for one that
+// leaves the frontier and stops at the first. Top-down is cheaper while the
+// frontier is small; once the frontier's arcs outnumber the arcs left to
+// explore by ALPHA the search turns bottom-up, and turns back once the
+// frontier shrinks below 1 / BETA of the vertices.
+// The visited set and the frontier are bitsets over the dense ids, so a
+// level costs no allocation and membership tests stay in cache. The result
+// is a predecessor tree, like Dijkstra's, from which paths are rebuilt.
+class DirectionOptimizingBfs {
+public:
+  enum Direction { AUTOMATIC, TOP_DOWN, BOTTOM_UP };
+
+private:
+  static constexpr int ALPHA = 14;
+  static constexpr int BETA = 24;
+
+  Direction direction;
+  Bitset visited;
+  Bitset inFrontier;
+  std::vector<int> current;
+  std::vector<int> next;
+  std::vector<int> level;
+  std::vector<int> parent;
+  std::vector<int> via;
+  int levelCount;
+  int bottomUpCount;
+  SearchStats work;
+
+  void visit(int v, int from, int arc, int depth) {
+    visited.set(v);
+    level[v] = depth;
+    parent[v] = from;
+    via[v] = arc;
+    next.push_back(v);
+    work.settled++;
+  }
+
+  // Expands current through its arcs; returns the arcs of the new frontier
+  long topDown(const CompactGraph &g, int depth) {
+    long scout = 0;
+    for (int u : current) {
+      work.pops++;
+      for (int arc = g.begin(u); arc < g.end(u); arc++) {
+        int v = g.targets[arc];
+        work.relaxed++;
+        if (!visited.test(v)) {
+          visit(v, u, arc, depth);
+          scout += g.degree(v);
+        }
+      }
+    }
+    return scout;
+  }
+
+  // Lets every unvisited vertex look for a parent in the frontier
+  long bottomUp(const CompactGraph &g, int depth) {
+    inFrontier.clear();
+    for (int u : current) {
+      inFrontier.set(u);
+    }
+
+    long scout = 0;
+    int n = g.vertexCount();
+    for (int w = 0; w < visited.wordCount(); w++) {
+      std::uint64_t open = ~visited.word(w);
+      while (open != 0) {
+        int v = w * 64 + __builtin_ctzll(open);
+        open &= open - 1;
+        if (v >= n) {
+          break;
+        }
+        for (int i = g.inBegin(v); i < g.inEnd(v); i++) {
+          work.relaxed++;
+          if (inFrontier.test(g.sources[i])) {
+            visit(v, g.sources[i], g.inArcs[i], depth);
+            scout += g.degree(v);
+            break;
+          }
+        }
+      }
+    }
+    work.pops += current.size();
+    bottomUpCount++;
+    return scout;
+  }
+
+public:
+  DirectionOptimizingBfs(Direction direction = AUTOMATIC) {
+    this->direction = direction;
+    levelCount = 0;
+    bottomUpCount = 0;
+  }
+
+  // Forces every level one way, for comparing the two
+  void setDirection(Direction direction) { this->direction = direction; }
+
+  // Labels vertices with their stop count from source, level by level,
+  // until target is reached or, when target is -1, everything reachable
+  // is. g must have its reverse index.
+  void run(const CompactGraph &g, int source, int target = -1) {
+    int n = g.vertexCount();
+    if ((int)level.size() != n) {
+      level.assign(n, UNREACHABLE);
+      parent.assign(n, -1);
+      via.assign(n, -1);
+      inFrontier.resize(n);
+    }
+    visited.resize(n);
+    current.clear();
+    next.clear();
+    levelCount = 0;
+    bottomUpCount = 0;
+    work.clear();
+
+    visit(source, -1, -1, 0);
+    work.pushed(1);
+    long unexplored = g.arcCount() - g.degree(source);
+    long scout = g.degree(source);
+    bool upward = direction == BOTTOM_UP;
+
+    while (!next.empty() && !(target != -1 && visited.test(target))) {
+      current.swap(next);
+      next.clear();
+      levelCount++;
+
+      if (direction == AUTOMATIC) {
+        if (!upward && scout > unexplored / ALPHA) {
+          upward = true;
+        } else if (upward && (long)current.size() * BETA < n) {
+          upward = false;
+        }
+      }
+
+      scout = upward ? bottomUp(g, levelCount) : topDown(g, levelCount);
+      unexplored -= scout;
+      work.pushes += next.size();
+      work.peakFrontier = std::max(work.peakFrontier, (long)next.size());
+    }
+
+    work.bytes = visited.bytes() + inFrontier.bytes() +
+                 (current.capacity() + next.capacity() + 3 * n) * sizeof(int);
+  }
+
+  bool reached(int v) const { return visited.test(v); }
+
+  // Fewest arcs from the source to v, UNREACHABLE if v was not reached
+  int distance(int v) const { return reached(v) ? level[v] : UNREACHABLE; }
+
+  // Predecessor of v in the BFS tree, -1 for the source
+  int parentOf(int v) const { return reached(v) ? parent[v] : -1; }
+
+  // Arc used to enter v in the BFS tree, -1 for the source
+  int arcTo(int v) const { return reached(v) ? via[v] : -1; }
+
+  // Arcs of the path from the source to v, in travel order
+  std::vector<int> pathArcs(int v) const {
+    std::vector<int> arcs;
+    if (!reached(v)) {
+      return arcs;
+    }
+    for (int u = v; parent[u] != -1; u = parent[u]) {
+      arcs.push_back(via[u]);
+    }
+    std::reverse(arcs.begin(), arcs.end());
+    return arcs;
+  }
+
+  // Levels expanded by the last run, and how many of them bottom-up
+  int levels() const { return levelCount; }
+
+  int bottomUpLevels() const { return bottomUpCount; }
+
+  // Counters of the last run; pops count frontier vertices expanded
+  const SearchStats &stats() const { return work; }
+};
+
+#endif
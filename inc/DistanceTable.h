@@ -0,0 +1,114 @@
+#ifndef DISTANCE_TABLE_H
+#define DISTANCE_TABLE_H
+
+#include <CompactGraph.h>
+#include <Dijkstra.h>
+#include <Parallel.h>
+#include <SearchStats.h>
+#include <vector>
+
+// Dense rows x cols matrix of shortest path lengths, row-major.
+// Entries are UNREACHABLE where no path exists.
+struct DistanceTable {
+  int rows;
+  int cols;
+  std::vector<int> values;
+
+  DistanceTable(int rows = 0, int cols = 0) {
+    this->rows = rows;
+    this->cols = cols;
+    values.assign((long)rows * cols, UNREACHABLE);
+  }
+
+  int at(int row, int col) const { return values[(long)row * cols + col]; }
+
+  int &at(int row, int col) { return values[(long)row * cols + col]; }
+};
+
+// Goal that stops a one-to-many search once every target is settled.
+// Targets are marked with a stamp, so switching target sets is O(targets).
+class TargetSet {
+  std::vector<unsigned> mark;
+  unsigned stamp;
+  int remaining;
+
+public:
+  TargetSet() {
+    stamp = 0;
+    remaining = 0;
+  }
+
+  void reset(int n, const std::vector<int> &targets) {
+    if ((int)mark.size() != n) {
+      mark.assign(n, 0);
+      stamp = 0;
+    }
+    stamp++;
+    remaining = 0;
+    for (int t : targets) {
+      if (t >= 0 && mark[t] != stamp) {
+        mark[t] = stamp;
+        remaining++;
+      }
+    }
+  }
+
+  bool operator()(int u) {
+    if (mark[u] == stamp) {
+      mark[u] = 0;
+      remaining--;
+    }
+    return remaining == 0;
+  }
+};
+
+// Many-to-many shortest path lengths. Each source gets a one-to-many
+// Dijkstra that stops as soon as all targets are settled. Sources are
+// independent and each writes only its own row, so they are spread over a
+// worker pool with one engine per worker and no shared mutable state, and
+// throughput grows with the number of cores.
+class ManyToMany {
+  std::vector<Dijkstra> engines;
+  std::vector<TargetSet> goals;
+  std::vector<SearchStats> workerStats;
+  SearchStats work;
+
+public:
+  // Lengths from every source to every target vertex id. An id of -1
+  // gives an UNREACHABLE row or column.
+  DistanceTable run(const CompactGraph &g, const std::vector<int> &sources,
+                    const std::vector<int> &targets, SearchCriteria criteria,
+                    int threads) {
+    DistanceTable table(sources.size(), targets.size());
+    threads = std::max(1, threads);
+    engines.resize(threads);
+    goals.resize(threads);
+    workerStats.assign(threads, SearchStats());
+
+    parallelFor(sources.size(), threads, [&](int i, int worker) {
+      if (sources[i] < 0) {
+        return;
+      }
+      Dijkstra &engine = engines[worker];
+      goals[worker].reset(g.vertexCount(), targets);
+      engine.runUntil(g, sources[i], criteria, goals[worker]);
+      workerStats[worker] += engine.stats();
+      for (std::size_t j = 0; j < targets.size(); j++) {
+        if (targets[j] >= 0) {
+          table.at(i, j) = engine.distance(targets[j]);
+        }
+      }
+    });
+
+    work.clear();
+    for (const SearchStats &w : workerStats) {
+      work += w;
+    }
+    return table;
+  }
+
+  // Counters of the last run, summed over every source
+  const SearchStats &stats() const { return work; }
+};
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef DYNAMIC_TREE_H
+#define DYNAMIC_TREE_H
+
+#include <CompactGraph.h>
+#include <Dijkstra.h>
+#include <IndexedHeap.h>
+#include <SearchStats.h>
+#include <algorithm>
+#include <vector>
+
+// One-to-all shortest path tree that is repaired, not recomputed, when an
+// arc's weight changes (after Ramalingam & Reps).
+// A cheaper arc can only shorten paths through it, so a Dijkstra is seeded
+// at its head and only runs while distances keep improving. A dearer arc
+// matters only if it is in the tree: the subtree hanging below it is cut
+// loose, each of its vertices takes the best entering arc from outside the
+// subtree as a tentative distance, and a Dijkstra restricted to the
+// subtree settles them again. Everything outside the affected vertices is
+// left untouched. Needs the graph's reverse index.
+class DynamicTree {
+  int root;
+  SearchCriteria mode;
+  std::vector<int> dist;
+  std::vector<int> parent;
+  std::vector<int> via;
+  std::vector<unsigned> cutIn; // stamp of the repair that cut the vertex
+  unsigned repair;
+  std::vector<int> subtree;
+  IndexedHeap<int> heap;
+  SearchStats work;
+
+  void reach(int v, int distance, int from, int arc) {
+    if (!heap.contains(v)) {
+      work.pushed(heap.size() + 1);
+    } else {
+      work.decreaseKeys++;
+    }
+    dist[v] = distance;
+    parent[v] = from;
+    via[v] = arc;
+    heap.pushOrDecrease(v, distance);
+  }
+
+  // Settles the queued vertices, relaxing into every vertex when cut is
+  // false and only into the vertices cut by this repair when it is true
+  void settle(const CompactGraph &g, bool cut) {
+    while (!heap.isEmpty()) {
+      int u = heap.pop();
+      work.pops++;
+      work.settled++;
+      for (int arc = g.begin(u); arc < g.end(u); arc++) {
+        int v = g.targets[arc];
+        work.relaxed++;
+        if (cut && cutIn[v] != repair) {
+          continue;
+        }
+        int candidate = dist[u] + g.weight(arc, mode);
+        if (candidate < dist[v]) {
+          reach(v, candidate, u, arc);
+        }
+      }
+    }
+  }
+
+  // Collects v and everything below it in the tree into subtree
+  void cutBelow(const CompactGraph &g, int v) {
+    subtree.clear();
+    subtree.push_back(v);
+    cutIn[v] = repair;
+    for (std::size_t i = 0; i < subtree.size(); i++) {
+      int u = subtree[i];
+      for (int arc = g.begin(u); arc < g.end(u); arc++) {
+        int w = g.targets[arc];
+        work.relaxed++;
+        if (via[w] == arc && cutIn[w] != repair) {
+          cutIn[w] = repair;
+          subtree.push_back(w);
+        }
+      }
+    }
+  }
+
+public:
+  // Graph::version the tree matches, -1 if never built
+  long version;
+
+  DynamicTree() {
+    root = -1;
+    mode = CHEAPEST;
+    repair = 0;
+    version = -1;
+  }
+
+  // Computes the whole tree from scratch
+  void build(const CompactGraph &g, int source, SearchCriteria criteria) {
+    int n = g.vertexCount();
+    root = source;
+    mode = criteria;
+    version = g.version;
+    work.clear();
+    dist.assign(n, UNREACHABLE);
+    parent.assign(n, -1);
+    via.assign(n, -1);
+    cutIn.assign(n, 0);
+    repair = 0;
+    heap.clear();
+    heap.resize(n);
+
+    reach(source, 0, -1, -1);
+    settle(g, false);
+    work.bytes = heap.bytes() + 4 * n * sizeof(int);
+  }
+
+  // Repairs the tree after arc's weight under its criteria changed from
+  // oldWeight to what g holds now. Returns the vertices whose distance
+  // had to be reconsidered.
+  int arcChanged(const CompactGraph &g, int arc, int oldWeight) {
+    work.clear();
+    version = g.version;
+    int weight = g.weight(arc, mode);
+    int u = g.tail(arc);
+    int v = g.targets[arc];
+    if (weight == oldWeight || dist[u] == UNREACHABLE) {
+      return 0;
+    }
+
+    if (weight < oldWeight) {
+      if (dist[u] + weight >= dist[v]) {
+        return 0;
+      }
+      reach(v, dist[u] + weight, u, arc);
+      settle(g, false);
+      return work.settled;
+    }
+
+    if (via[v] != arc) {
+      return 0;
+    }
+    repair++;
+    cutBelow(g, v);
+    for (int x : subtree) {
+      dist[x] = UNREACHABLE;
+      parent[x] = -1;
+      via[x] = -1;
+    }
+    for (int x : subtree) {
+      int best = UNREACHABLE;
+      for (int i = g.inBegin(x); i < g.inEnd(x); i++) {
+        int y = g.sources[i];
+        work.relaxed++;
+        if (cutIn[y] == repair || dist[y] == UNREACHABLE) {
+          continue;
+        }
+        int candidate = dist[y] + g.weight(g.inArcs[i], mode);
+        if (candidate < best) {
+          best = candidate;
+          parent[x] = y;
+          via[x] = g.inArcs[i];
+        }
+      }
+      if (best != UNREACHABLE) {
+        reach(x, best, parent[x], via[x]);
+      }
+    }
+    settle(g, true);
+    return subtree.size();
+  }
+
+  int source() const { return root; }
+
+  SearchCriteria criteria() const { return mode; }
+
+  bool reached(int v) const { return dist[v] != UNREACHABLE; }
+
+  int distance(int v) const { return dist[v]; }
+
+  // Predecessor of v in the tree, -1 for the source and unreached vertices
+  int parentOf(int v) const { return parent[v]; }
+
+  // Arc used to enter v in the tree, -1 for the source
+  int arcTo(int v) const { return via[v]; }
+
+  // Arcs of the path from the source to v, in travel order
+  std::vector<int> pathArcs(int v) const {
+    std::vector<int> arcs;
+    if (!reached(v)) {
+      return arcs;
+    }
+    for (int u = v; parent[u] != -1; u = parent[u]) {
+      arcs.push_back(via[u]);
+    }
+    std::reverse(arcs.begin(), arcs.end());
+    return arcs;
+  }
+
+  // Counters of the last build or repair
+  const SearchStats &stats() const { return work; }
+};
+
+#endif
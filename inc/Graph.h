@@ -2,18 +2,38 @@
 #define GRAPH_H
 
 #include "LinkedList.h"
+#include <AStar.h>
+#include <AllPairsTable.h>
 #include <ArrayList.h>
+#include <BidirectionalDijkstra.h>
+#include <CompactGraph.h>
+#include <ConnectionScan.h>
+#include <ConstrainedSearch.h>
+#include <ContractionHierarchy.h>
+#include <Dijkstra.h>
+#include <DirectionOptimizingBfs.h>
+#include <DistanceTable.h>
+#include <DynamicTree.h>
 #include <HashTable.h>
-#include <Queue.h>
-#include <Stack.h>
+#include <KShortestPaths.h>
+#include <LRUCache.h>
+#include <LabelArena.h>
+#include <Landmarks.h>
+#include <OptimalPaths.h>
+#include <ParetoSearch.h>
+#include <Raptor.h>
+#include <Reachability.h>
+#include <SearchStats.h>
+#include <SearchTrace.h>
+#include <ShortestPathTree.h>
+#include <TourPlanner.h>
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <ostream>
 #include <string>
 #include <vector>
 
-enum SearchCriteria { CHEAPEST, FASTEST, LEAST_STOPS };
-
 struct Edge;
 
 struct Vertex {
@@ -21,11 +41,13 @@ struct Vertex {
   ArrayList<Edge *> edgeList;
   int x;
   int y;
+  int id; // Dense index into Graph::vertices, -1 until added to a graph
 
   Vertex(std::string data, int x = 0, int y = 0) {
     this->data = data;
     this->x = x;
     this->y = y;
+    this->id = -1;
   }
 
   ~Vertex();
@@ -96,30 +118,35 @@ struct Waypoint : public std::enable_shared_from_this<Waypoint> {
     stops = 0;
   }
 
+  // Extend this waypoint along e, accumulating the totals of the itinerary
+  std::shared_ptr<Waypoint> follow(Edge *e,
+                                   SearchCriteria criteria = CHEAPEST) {
+    std::shared_ptr<Waypoint> temp = std::make_shared<Waypoint>(e->to);
+    temp->parent = shared_from_this();
+
+    temp->totalCost = totalCost + e->cost;
+    temp->totalTime = totalTime + e->duration;
+    temp->stops = stops + 1;
+
+    // Set partial cost based on criteria
+    if (criteria == CHEAPEST) {
+      temp->partialCost = temp->totalCost;
+    } else if (criteria == FASTEST) {
+      temp->partialCost = temp->totalTime;
+    } else { // LEAST_STOPS
+      temp->partialCost = temp->stops;
+    }
+
+    temp->weight = e->weight;
+
+    return temp;
+  }
+
   std::vector<std::shared_ptr<Waypoint>>
   expand(SearchCriteria criteria = CHEAPEST) {
     std::vector<std::shared_ptr<Waypoint>> children;
     for (int i = 0; i < vertex->edgeList.size(); i++) {
-      Edge *e = vertex->edgeList[i];
-      std::shared_ptr<Waypoint> temp = std::make_shared<Waypoint>(e->to);
-      temp->parent = shared_from_this();
-
-      temp->totalCost = totalCost + e->cost;
-      temp->totalTime = totalTime + e->duration;
-      temp->stops = stops + 1;
-
-      // Set partial cost based on criteria
-      if (criteria == CHEAPEST) {
-        temp->partialCost = temp->totalCost;
-      } else if (criteria == FASTEST) {
-        temp->partialCost = temp->totalTime;
-      } else { // LEAST_STOPS
-        temp->partialCost = temp->stops;
-      }
-
-      temp->weight = e->weight;
-
-      children.push_back(temp);
+      children.push_back(follow(vertex->edgeList[i], criteria));
     }
     return children;
   }
@@ -136,353 +163,1019 @@ inline std::ostream &operator<<(std::ostream &os, Waypoint *wp) {
   return os;
 }
 
+// One-to-all trees Graph::searchCached() keeps for reuse
+const int TREE_CACHE_SIZE = 8;
+
+// Cache key of a query: its endpoints, criteria and an encoding of any
+// further parameters that change the answer. findRoutes() uses 0; a
+// budgeted search packs limited + 1 above its budget, so its keys never
+// coincide with a findRoutes() key.
+struct QueryKey {
+  int from;
+  int to;
+  int criteria;
+  unsigned long constraint;
+
+  bool operator==(const QueryKey &other) const {
+    return from == other.from && to == other.to &&
+           criteria == other.criteria && constraint == other.constraint;
+  }
+};
+
+struct QueryKeyHash {
+  std::size_t operator()(const QueryKey &k) const {
+    unsigned long h = 14695981039346656037ul;
+    h = (h ^ (unsigned long)k.from) * 1099511628211ul;
+    h = (h ^ (unsigned long)k.to) * 1099511628211ul;
+    h = (h ^ (unsigned long)k.criteria) * 1099511628211ul;
+    h = (h ^ k.constraint) * 1099511628211ul;
+    return h;
+  }
+};
+
+// Recent answers of findRoutes() and searchConstrained()
+typedef LRUCache<QueryKey, std::vector<std::shared_ptr<Waypoint>>,
+                 QueryKeyHash>
+    QueryCache;
+
+const int QUERY_CACHE_SIZE = 256;
+
 struct Graph {
   ArrayList<Vertex *> vertices;
 
+  // Bumped by every mutation so derived structures can detect staleness
+  long version = 0;
+
   ~Graph() {
     for (int i = 0; i < vertices.size(); i++) {
       delete vertices[i];
     }
   }
 
-  void addVertex(Vertex *v) { vertices.append(v); }
+  void addVertex(Vertex *v) {
+    bool current = reachIndex.version == version;
+    v->id = vertices.size();
+    vertices.append(v);
+    version++;
+    if (current) {
+      reachIndex.addVertex();
+      reachIndex.version = version;
+    }
+  }
+
+  // True if v was added to this graph (its id indexes back to it)
+  bool contains(Vertex *v) const {
+    return v != nullptr && v->id >= 0 && v->id < vertices.size() &&
+           vertices[v->id] == v;
+  }
 
   void addEdge(Vertex *x, Vertex *y, int cost, int duration) {
+    bool current = reachIndex.version == version && contains(x) && contains(y);
     x->edgeList.append(new Edge(x, y, cost, duration));
     y->edgeList.append(new Edge(y, x, cost, duration));
+    version++;
+    if (current) {
+      reachIndex.addArc(x->id, y->id);
+      reachIndex.addArc(y->id, x->id);
+      reachIndex.version = version;
+    }
   }
 
   void addDirectedEdge(Vertex *x, Vertex *y, int cost, int duration) {
+    bool current = reachIndex.version == version && contains(x) && contains(y);
     x->edgeList.append(new Edge(x, y, cost, duration));
+    version++;
+    if (current) {
+      reachIndex.addArc(x->id, y->id);
+      reachIndex.version = version;
+    }
   }
 
   // Legacy support
   void addEdge(Vertex *x, Vertex *y, int w) { addEdge(x, y, w, 0); }
 
-  std::shared_ptr<Waypoint> bfs(Vertex *start, Vertex *destination) {
-    std::cout << "Running Breadth-First Search" << std::endl;
-    Queue<std::shared_ptr<Waypoint>> frontier;
-    HashTable<std::string> seen;
+  // Changes one flight's fare and duration in place. The return flight of
+  // an addEdge() pair is a separate Edge and keeps its values. When the
+  // snapshot is current it is patched rather than rebuilt, and the trees
+  // cached by searchCached() are repaired around the flight.
+  void updateEdge(Edge *e, int cost, int duration) {
+    Vertex *u = e->from;
+    int position = -1;
+    for (int j = 0; contains(u) && j < u->edgeList.size(); j++) {
+      if (u->edgeList[j] == e) {
+        position = j;
+      }
+    }
+    if (position == -1) {
+      throw std::logic_error("Edge is not in the graph");
+    }
+
+    bool current = snapshot.version == version;
+    int oldCost = e->cost;
+    int oldDuration = e->duration;
+    e->cost = cost;
+    e->duration = duration;
+    e->weight = cost;
+    if (reachIndex.version == version) {
+      reachIndex.version = version + 1;
+    }
+    version++;
+    if (!current) {
+      return;
+    }
 
-    std::shared_ptr<Waypoint> first = std::make_shared<Waypoint>(start);
+    int arc = snapshot.begin(u->id) + position;
+    snapshot.setArc(arc, cost, duration);
+    snapshot.version = version;
+    for (DynamicTree &tree : trees) {
+      if (tree.version != version - 1) {
+        continue;
+      }
+      // Every flight counts 1 toward stops, so those trees stand as they are
+      if (tree.criteria() == LEAST_STOPS) {
+        tree.version = version;
+      } else {
+        int old = tree.criteria() == CHEAPEST ? oldCost : oldDuration;
+        tree.arcChanged(snapshot, arc, old);
+      }
+    }
+  }
 
-    frontier.enqueue(first);
-    seen.insert(first->vertex->data);
+  // Pack the adjacency into a CompactGraph over the dense vertex ids.
+  // The snapshot is cached and only rebuilt after the graph has changed.
+  const CompactGraph &freeze() {
+    if (snapshot.version == version) {
+      return snapshot;
+    }
 
-    std::shared_ptr<Waypoint> result = nullptr;
+    int arcs = 0;
+    for (int i = 0; i < vertices.size(); i++) {
+      arcs += vertices[i]->edgeList.size();
+    }
 
-    while (!frontier.isEmpty()) {
-      result = frontier.dequeue();
+    CompactGraph compact;
+    compact.offsets.reserve(vertices.size() + 1);
+    compact.targets.reserve(arcs);
+    compact.costs.reserve(arcs);
+    compact.durations.reserve(arcs);
 
-      if (result->vertex == destination) {
-        return result;
+    for (int i = 0; i < vertices.size(); i++) {
+      Vertex *u = vertices[i];
+      compact.addVertex(u->x, u->y);
+      for (int j = 0; j < u->edgeList.size(); j++) {
+        Edge *e = u->edgeList[j];
+        if (!contains(e->to)) {
+          throw std::logic_error("Edge leads to a vertex outside the graph");
+        }
+        compact.addArc(e->to->id, e->cost, e->duration);
       }
+    }
+
+    compact.buildReverse();
+    compact.computeBounds();
+    compact.version = version;
+    snapshot = std::move(compact);
+    return snapshot;
+  }
+
+  // Which airports can reach which at all, kept up to date as airports and
+  // flights are added and only rebuilt after other changes
+  const Reachability &reachability() {
+    if (reachIndex.version != version) {
+      reachIndex.build(freeze());
+    }
+    return reachIndex;
+  }
+
+  // The Edge behind arc of the frozen snapshot, given the arc's tail u
+  Edge *arcEdge(int u, int arc) const {
+    return vertices[u]->edgeList[arc - snapshot.begin(u)];
+  }
 
-      std::vector<std::shared_ptr<Waypoint>> children = result->expand();
-      // Get the neighbors of the current vertex
-      // that we are on...
+  // Rebuild the Waypoint chain that follows arcs out of source
+  std::shared_ptr<Waypoint> pathFromArcs(int source,
+                                         const std::vector<int> &arcs,
+                                         SearchCriteria criteria) const {
+    std::shared_ptr<Waypoint> result =
+        std::make_shared<Waypoint>(vertices[source]);
+    int u = source;
+    for (int arc : arcs) {
+      result = result->follow(arcEdge(u, arc), criteria);
+      u = snapshot.targets[arc];
+    }
+    return result;
+  }
+
+  // Breadth-first search. The frontier holds labels of a reusable arena
+  // instead of Waypoints, so a query allocates nothing once the arena and
+  // frontier have grown, and only the answer becomes a Waypoint chain.
+  // Steps are reported to trace (see SearchTrace.h).
+  // Like every search below it fills stats, when given, with the work done.
+  template <class Trace>
+  std::shared_ptr<Waypoint> bfs(Vertex *start, Vertex *destination,
+                                Trace &trace, SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    if (!contains(start) || !contains(destination)) {
+      return nullptr;
+    }
+
+    const CompactGraph &compact = freeze();
+    timer.frozen();
+    if (!routeExists(start, destination, timer)) {
+      return nullptr;
+    }
+    std::vector<bool> seen(compact.vertexCount(), false);
+    SearchStats work;
+    labels.clear();
+    frontier.clear();
+
+    frontier.push_back(labels.root(start->id));
+    work.pushed(1);
+    seen[start->id] = true;
+
+    // The queue is frontier[head..], so dequeuing just advances head
+    int found = -1;
+    for (std::size_t head = 0; head < frontier.size(); head++) {
+      int result = frontier[head];
+      int u = labels[result].vertex;
+      work.pops++;
+      work.settled++;
+
+      if (u == destination->id) {
+        found = result;
+        break;
+      }
 
-      // The neighbors are stored in the result->children array
-      std::cout << std::endl
-                << "Expanding " << result->vertex->data << std::endl;
+      trace.expand(u);
 
-      for (auto &child : children) {
-        // For every child of the result node
+      for (int arc = compact.begin(u); arc < compact.end(u); arc++) {
+        // For every neighbor of the current vertex
         // If we have not seen it
         // We add it to the frontier (as a queue)
         // We mark it as seen
-        if (!seen.search(child->vertex->data)) {
-          std::cout << "Adding " << child->vertex->data << std::endl;
-          frontier.enqueue(child);
-          seen.insert(child->vertex->data);
+        int v = compact.targets[arc];
+        work.relaxed++;
+        if (!seen[v]) {
+          frontier.push_back(labels.extend(result, arc, compact));
+          trace.push(v, labels[frontier.back()].cost);
+          work.pushed(frontier.size() - head - 1);
+          seen[v] = true;
         }
       }
+    }
+
+    return finishLabelSearch(start, found, work, timer);
+  }
+
+  std::shared_ptr<Waypoint> bfs(Vertex *start, Vertex *destination,
+                                SearchStats *stats = nullptr) {
+    SilentTrace trace;
+    return bfs(start, destination, trace, stats);
+  }
 
-      std::cout << std::endl << "Frontier" << std::endl;
+  // Depth-first search, with the same label arena as bfs()
+  template <class Trace>
+  std::shared_ptr<Waypoint> dfs(Vertex *start, Vertex *destination,
+                                Trace &trace, SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    if (!contains(start) || !contains(destination)) {
+      return nullptr;
+    }
+
+    const CompactGraph &compact = freeze();
+    timer.frozen();
+    if (!routeExists(start, destination, timer)) {
+      return nullptr;
+    }
+    std::vector<bool> seen(compact.vertexCount(), false);
+    SearchStats work;
+    labels.clear();
+    frontier.clear();
+
+    frontier.push_back(labels.root(start->id));
+    work.pushed(1);
+    seen[start->id] = true;
+
+    // The stack's top is the back of frontier
+    int found = -1;
+    while (!frontier.empty()) {
+      int result = frontier.back();
+      frontier.pop_back();
+      int u = labels[result].vertex;
+      work.pops++;
+      work.settled++;
+
+      if (u == destination->id) {
+        found = result;
+        break;
+      }
 
-      Link<std::shared_ptr<Waypoint>> *temp = frontier.list.front;
-      while (temp != nullptr) {
-        std::cout << "(" << temp->data->vertex->data << ","
-                  << temp->data->partialCost << ")";
-        temp = temp->next;
+      trace.expand(u);
 
-        if (temp != nullptr) {
-          std::cout << ", ";
-        } else {
-          std::cout << std::endl;
+      for (int arc = compact.begin(u); arc < compact.end(u); arc++) {
+        int v = compact.targets[arc];
+        work.relaxed++;
+        if (!seen[v]) {
+          frontier.push_back(labels.extend(result, arc, compact));
+          trace.push(v, labels[frontier.back()].cost);
+          work.pushed(frontier.size());
+          seen[v] = true;
         }
       }
-      std::cout << std::endl;
     }
 
-    return nullptr;
+    return finishLabelSearch(start, found, work, timer);
+  }
+
+  std::shared_ptr<Waypoint> dfs(Vertex *start, Vertex *destination,
+                                SearchStats *stats = nullptr) {
+    SilentTrace trace;
+    return dfs(start, destination, trace, stats);
   }
 
-  std::shared_ptr<Waypoint> dfs(Vertex *start, Vertex *destination) {
-    std::cout << "Running Depth-First Search" << std::endl;
+  // Dijkstra over the frozen snapshot. The frontier is an indexed heap keyed
+  // by the best known partial cost, so a cheaper route to a queued airport
+  // is a decrease-key instead of a rescan and resort of the frontier.
+  template <class Trace>
+  std::shared_ptr<Waypoint> search(Vertex *start, Vertex *destination,
+                                   SearchCriteria criteria, Trace &trace,
+                                   SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    if (!contains(start) || !contains(destination)) {
+      return nullptr;
+    }
 
-    Stack<std::shared_ptr<Waypoint>> frontier;
-    HashTable<std::string> seen;
+    const CompactGraph &compact = freeze();
+    timer.frozen();
+    if (!routeExists(start, destination, timer)) {
+      return nullptr;
+    }
+    engine.run(compact, start->id, destination->id, criteria, trace);
+    return finishEngineSearch(start, destination, criteria, timer);
+  }
 
-    std::shared_ptr<Waypoint> first = std::make_shared<Waypoint>(start);
+  // Untraced fewest-stops queries go to searchFewestStops()
+  std::shared_ptr<Waypoint> search(Vertex *start, Vertex *destination,
+                                   SearchCriteria criteria,
+                                   SearchStats *stats = nullptr) {
+    if (criteria == LEAST_STOPS) {
+      return searchFewestStops(start, destination, stats);
+    }
+    SilentTrace trace;
+    return search(start, destination, criteria, trace, stats);
+  }
 
-    frontier.push(first);
-    seen.insert(first->vertex->data);
+  // Fewest-stops itinerary by a direction-optimizing breadth-first search
+  // over bitsets, with no heap and no per-airport allocation
+  std::shared_ptr<Waypoint> searchFewestStops(Vertex *start,
+                                              Vertex *destination,
+                                              SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    if (!contains(start) || !contains(destination)) {
+      return nullptr;
+    }
 
-    std::shared_ptr<Waypoint> result = nullptr;
+    const CompactGraph &compact = freeze();
+    timer.frozen();
+    if (!routeExists(start, destination, timer)) {
+      return nullptr;
+    }
+    stopsEngine.run(compact, start->id, destination->id);
+    lastSettled = stopsEngine.stats().settled;
+    timer.searched(stopsEngine.stats());
 
-    while (!frontier.isEmpty()) {
-      result = frontier.pop();
+    if (!stopsEngine.reached(destination->id)) {
+      return nullptr;
+    }
+    std::shared_ptr<Waypoint> result = pathFromArcs(
+        start->id, stopsEngine.pathArcs(destination->id), LEAST_STOPS);
+    timer.built();
+    return result;
+  }
 
-      if (result->vertex == destination) {
-        return result;
+  // Writes the steps recorded by a traced search in words, one per line
+  void printTrace(const RingTrace &trace, std::ostream &os) const {
+    if (trace.dropped() > 0) {
+      os << "(" << trace.dropped() << " earlier steps not kept)" << std::endl;
+    }
+    for (int i = 0; i < trace.size(); i++) {
+      const TraceEvent &e = trace[i];
+      const std::string &name = vertices[e.vertex]->data;
+      if (e.kind == TraceEvent::EXPAND) {
+        os << "Expanding " << name << std::endl;
+      } else if (e.kind == TraceEvent::PUSH) {
+        os << "Adding " << name << std::endl;
+      } else {
+        os << "Found another way to get to " << name << ". Was " << e.was
+           << ", but now it is " << e.now << std::endl;
       }
+    }
+  }
 
-      std::vector<std::shared_ptr<Waypoint>> children = result->expand();
+  // A* over the frozen snapshot, guided by the airports' map coordinates.
+  // Returns the same optimal itinerary as search() while settling fewer
+  // airports when the network is spread out on the map.
+  std::shared_ptr<Waypoint> astar(Vertex *start, Vertex *destination,
+                                  SearchCriteria criteria,
+                                  SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    if (!contains(start) || !contains(destination)) {
+      return nullptr;
+    }
 
-      std::cout << std::endl
-                << "Expanding " << result->vertex->data << std::endl;
+    const CompactGraph &compact = freeze();
+    timer.frozen();
+    if (!routeExists(start, destination, timer)) {
+      return nullptr;
+    }
+    SilentTrace trace;
+    GeometricPotential potential(compact, destination->id, criteria);
+    engine.run(compact, start->id, destination->id, criteria, trace,
+               potential);
+    return finishEngineSearch(start, destination, criteria, timer);
+  }
 
-      for (auto &child : children) {
-        if (!seen.search(child->vertex->data)) {
-          std::cout << "Adding " << child->vertex->data << std::endl;
-          frontier.push(child);
-          seen.insert(child->vertex->data);
-        }
-      }
+  // ALT: A* guided by precomputed landmark distance tables of this graph,
+  // which bound fares as well as times
+  std::shared_ptr<Waypoint> astar(Vertex *start, Vertex *destination,
+                                  SearchCriteria criteria,
+                                  const Landmarks &landmarks,
+                                  SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    if (!contains(start) || !contains(destination)) {
+      return nullptr;
+    }
 
-      std::cout << std::endl << "Frontier" << std::endl;
+    const CompactGraph &compact = freeze();
+    if (landmarks.version != compact.version) {
+      throw std::logic_error("Landmark tables are out of date");
+    }
+    timer.frozen();
+    if (!routeExists(start, destination, timer)) {
+      return nullptr;
+    }
 
-      Link<std::shared_ptr<Waypoint>> *temp = frontier.front;
-      while (temp != nullptr) {
-        std::cout << "(" << temp->data->vertex->data << ","
-                  << temp->data->partialCost << ")";
-        temp = temp->next;
+    SilentTrace trace;
+    LandmarkPotential potential(landmarks, destination->id, criteria);
+    engine.run(compact, start->id, destination->id, criteria, trace,
+               potential);
+    return finishEngineSearch(start, destination, criteria, timer);
+  }
 
-        if (temp != nullptr) {
-          std::cout << ", ";
-        } else {
-          std::cout << std::endl;
-        }
-      }
-      std::cout << std::endl;
+  // Dijkstra from both ends at once over the snapshot's reverse index.
+  // Returns an optimal itinerary for any criteria, meant for single-pair
+  // queries such as Find Route.
+  std::shared_ptr<Waypoint> searchBidirectional(Vertex *start,
+                                                Vertex *destination,
+                                                SearchCriteria criteria,
+                                                SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    if (!contains(start) || !contains(destination)) {
+      return nullptr;
+    }
+
+    const CompactGraph &compact = freeze();
+    timer.frozen();
+    if (!routeExists(start, destination, timer)) {
+      return nullptr;
     }
+    pairEngine.run(compact, start->id, destination->id, criteria);
+    lastSettled = pairEngine.settledVertices();
+    timer.searched(pairEngine.stats());
 
-    return nullptr;
+    if (!pairEngine.found()) {
+      return nullptr;
+    }
+    std::shared_ptr<Waypoint> result =
+        pathFromArcs(start->id, pairEngine.pathArcs(), criteria);
+    timer.built();
+    return result;
   }
 
-  std::shared_ptr<Waypoint> search(Vertex *start, Vertex *destination,
-                                   SearchCriteria criteria) {
-    std::cout << "Running Search (UCS variant)" << std::endl;
+  // Query a prebuilt ContractionHierarchy of this graph and unpack its
+  // shortcuts into the usual Waypoint chain, priced under the criteria the
+  // hierarchy was built for
+  std::shared_ptr<Waypoint> searchHierarchy(Vertex *start, Vertex *destination,
+                                            ContractionHierarchy &ch,
+                                            SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    if (!contains(start) || !contains(destination)) {
+      return nullptr;
+    }
+    if (ch.version != freeze().version) {
+      throw std::logic_error("Contraction hierarchy is out of date");
+    }
+    timer.frozen();
+    if (!routeExists(start, destination, timer)) {
+      return nullptr;
+    }
 
-    // Should be a priority queue
-    ArrayList<std::shared_ptr<Waypoint>> frontier;
-    HashTable<std::string> seen;
+    std::vector<int> arcs = ch.pathArcs(start->id, destination->id);
+    lastSettled = ch.settledVertices();
+    timer.searched(ch.stats());
+    if (arcs.empty() && start != destination) {
+      return nullptr;
+    }
+    std::shared_ptr<Waypoint> result =
+        pathFromArcs(start->id, arcs, ch.getCriteria());
+    timer.built();
+    return result;
+  }
 
-    std::shared_ptr<Waypoint> first = std::make_shared<Waypoint>(start);
+  // The itinerary minimising objective whose total under limited stays
+  // within budget, e.g. the fastest one costing at most $800 with
+  // (FASTEST, CHEAPEST, 800). Priced under objective; null if none fits.
+  std::shared_ptr<Waypoint> searchConstrained(Vertex *start,
+                                              Vertex *destination,
+                                              SearchCriteria objective,
+                                              SearchCriteria limited,
+                                              int budget,
+                                              SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    if (!contains(start) || !contains(destination)) {
+      return nullptr;
+    }
 
-    frontier.append(first);
-    seen.insert(first->vertex->data);
+    QueryKey key = {start->id, destination->id, objective,
+                    (unsigned long)(limited + 1) << 32 | (unsigned)budget};
+    const std::vector<std::shared_ptr<Waypoint>> *cached =
+        queryCache.find(key, version);
+    if (cached != nullptr) {
+      timer.searched(SearchStats());
+      return cached->empty() ? nullptr : cached->front();
+    }
 
-    std::shared_ptr<Waypoint> result = nullptr;
+    const CompactGraph &compact = freeze();
+    timer.frozen();
+    if (!routeExists(start, destination, timer)) {
+      return nullptr;
+    }
+    budgetEngine.run(compact, start->id, destination->id, objective, limited,
+                     budget);
+    lastSettled = budgetEngine.stats().settled;
+    timer.searched(budgetEngine.stats());
+
+    std::vector<std::shared_ptr<Waypoint>> answer;
+    if (budgetEngine.foundPath()) {
+      answer.push_back(
+          pathFromArcs(start->id, budgetEngine.pathArcs(), objective));
+    }
+    queryCache.insert(key, answer, version);
+    timer.built();
+    return answer.empty() ? nullptr : answer.front();
+  }
 
-    while (frontier.size() != 0) {
-      result = frontier.removeLast();
+  // Dijkstra answered from a cached one-to-all tree of start. The last few
+  // trees are kept, and updateEdge() repairs them instead of dropping
+  // them, so repeated queries from an origin stay cheap while fares move.
+  std::shared_ptr<Waypoint> searchCached(Vertex *start, Vertex *destination,
+                                         SearchCriteria criteria,
+                                         SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    if (!contains(start) || !contains(destination)) {
+      return nullptr;
+    }
 
-      if (result->vertex == destination) {
-        return result;
+    const CompactGraph &compact = freeze();
+    timer.frozen();
+    if (!routeExists(start, destination, timer)) {
+      return nullptr;
+    }
+    DynamicTree *tree = nullptr;
+    for (DynamicTree &t : trees) {
+      if (t.version == compact.version && t.source() == start->id &&
+          t.criteria() == criteria) {
+        tree = &t;
       }
-
-      std::vector<std::shared_ptr<Waypoint>> children =
-          result->expand(criteria);
-
-      std::cout << "Expanding " << result->vertex->data << std::endl;
-
-      for (auto &child : children) {
-        // Look at each child
-        if (!seen.search(child->vertex->data)) {
-          // If not in the seen list, let's add it
-          std::cout << "Adding " << child->vertex->data << std::endl;
-          frontier.append(child);
-
-          // Sort the frontier....
-          int j = frontier.size() - 1;
-          while (j > 0 && frontier.data[j]->partialCost >
-                              frontier.data[j - 1]->partialCost) {
-
-            std::shared_ptr<Waypoint> temp = frontier.data[j];
-            frontier.data[j] = frontier.data[j - 1];
-            frontier.data[j - 1] = temp;
-            j--;
-          }
-
-          seen.insert(child->vertex->data);
-        } else {
-          // If it is in the seen list, we may have to do some work
-
-          // First we will check if it is still in the frontier but
-          // with a higher partial cost
-          std::shared_ptr<Waypoint> worsePath = nullptr;
-
-          for (int k = 0; k < frontier.size(); k++) {
-            if (frontier[k]->vertex->data == child->vertex->data) {
-              if (frontier[k]->partialCost > child->partialCost) {
-                worsePath = frontier[k];
-                // The same node was visited before,
-                // but with a higher partial cost
-                break;
-              }
-            }
-          }
-
-          // If we had a worse node before, we need to change it.
-          if (worsePath) {
-            std::cout << "Found another way to get to " << child->vertex->data
-                      << ". Was " << worsePath->partialCost
-                      << ", but now it is " << child->partialCost << std::endl;
-
-            // Make it so that the children of the worse waypoint
-            // become our children
-            for (int k = 0; k < frontier.size(); k++) {
-              if (frontier[k]->parent->vertex->data == child->vertex->data) {
-                frontier[k]->parent = child;
-              }
-            }
-
-            // Replace the worse one with the better one
-            for (int k = 0; k < frontier.size(); k++) {
-              if (frontier[k]->vertex->data == child->vertex->data) {
-                // delete frontier[k];
-                frontier[k] = child;
-                break;
-              }
-            }
-
-            // Sort the frontier because the replacement above
-            // may have caused things to fall out of order
-            for (int a = 1; a < frontier.size(); a++) {
-              int b = a;
-              while (b > 0 &&
-                     frontier[b]->partialCost > frontier[b - 1]->partialCost) {
-                std::shared_ptr<Waypoint> x = frontier[b];
-                frontier[b] = frontier[b - 1];
-                frontier[b - 1] = x;
-                b--;
-              }
-            }
-          }
-        }
+    }
+    if (tree == nullptr) {
+      if ((int)trees.size() < TREE_CACHE_SIZE) {
+        trees.push_back(DynamicTree());
+        tree = &trees.back();
+      } else {
+        tree = &trees[nextTree];
+        nextTree = (nextTree + 1) % TREE_CACHE_SIZE;
       }
+      tree->build(compact, start->id, criteria);
+      lastSettled = tree->stats().settled;
+      timer.searched(tree->stats());
+    } else {
+      lastSettled = 0;
+      timer.searched(SearchStats());
+    }
 
-      std::cout << std::endl << "Frontier" << std::endl;
+    if (!tree->reached(destination->id)) {
+      return nullptr;
+    }
+    std::shared_ptr<Waypoint> result =
+        pathFromArcs(start->id, tree->pathArcs(destination->id), criteria);
+    timer.built();
+    return result;
+  }
 
-      for (int k = frontier.size() - 1; k >= 0; k--) {
-        std::cout << "(" << frontier[k]->vertex->data << ", "
-                  << frontier[k]->partialCost << ") ";
-        if (k > 0) {
-          std::cout << ", ";
-        } else {
-          std::cout << std::endl;
-        }
-      }
-      std::cout << std::endl;
+  // Every airport reachable from source for at most bound under criteria,
+  // with distances and parents, from one Dijkstra that stops at the first
+  // airport past the bound. Without a bound it covers everything reachable.
+  ShortestPathTree shortestPathTree(Vertex *source, SearchCriteria criteria,
+                                    int bound = UNREACHABLE,
+                                    SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    if (!contains(source)) {
+      return ShortestPathTree();
     }
 
-    return nullptr;
+    const CompactGraph &compact = freeze();
+    timer.frozen();
+    ShortestPathTree tree(compact, engine, source->id, criteria, bound);
+    lastSettled = engine.settledVertices();
+    timer.searched(engine.stats());
+    return tree;
+  }
+
+  // "Where can I fly from source for at most bound": an itinerary to every
+  // other airport within the bound, cheapest (under criteria) first
+  std::vector<std::shared_ptr<Waypoint>>
+  isochrone(Vertex *source, SearchCriteria criteria, int bound,
+            SearchStats *stats = nullptr) {
+    std::vector<std::shared_ptr<Waypoint>> reachable;
+    ShortestPathTree tree = shortestPathTree(source, criteria, bound, stats);
+    for (int v : tree.order) {
+      if (v != tree.source) {
+        reachable.push_back(pathFromArcs(tree.source, tree.pathArcs(v),
+                                         criteria));
+      }
+    }
+    return reachable;
   }
 
+  // Airports settled by the most recent single-pair search
+  int lastSettledCount() const { return lastSettled; }
+
   // Keep legacy UCS for compatibility if needed, but it calls search with
   // default
   std::shared_ptr<Waypoint> ucs(Vertex *start, Vertex *destination) {
     return search(start, destination, CHEAPEST);
   }
 
-  // Search for ALL optimal paths with the same cost
+  // Search for ALL optimal paths with the same cost.
+  // One Dijkstra pass, run on past the destination to every airport tied
+  // with it, gives the tight arcs; the optimal routes are the simple paths
+  // over them and are listed by backtracking, at most limit of them if
+  // given.
   std::vector<std::shared_ptr<Waypoint>>
-  searchAll(Vertex *start, Vertex *destination, SearchCriteria criteria) {
+  searchAll(Vertex *start, Vertex *destination, SearchCriteria criteria,
+            int limit = -1, SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
     std::vector<std::shared_ptr<Waypoint>> allPaths;
+    if (!contains(start) || !contains(destination)) {
+      return allPaths;
+    }
 
-    // First, find the optimal cost using standard search
-    std::shared_ptr<Waypoint> optimalPath = search(start, destination, criteria);
-    if (!optimalPath) {
-      return allPaths; // No path found
+    const CompactGraph &compact = freeze();
+    timer.frozen();
+    if (!routeExists(start, destination, timer)) {
+      return allPaths;
+    }
+    PastTarget goal = {&engine, destination->id, UNREACHABLE};
+    engine.runUntil(compact, start->id, criteria, goal);
+    lastSettled = engine.settledVertices();
+
+    OptimalPaths optimal(compact, engine, start->id, destination->id,
+                         criteria);
+    std::vector<std::vector<int>> routes = optimal.enumerate(limit);
+    timer.searched(engine.stats());
+    for (const std::vector<int> &arcs : routes) {
+      allPaths.push_back(pathFromArcs(start->id, arcs, criteria));
     }
+    timer.built();
+    return allPaths;
+  }
 
-    int optimalCost = optimalPath->partialCost;
-    allPaths.push_back(optimalPath);
+  // searchAll answered from precomputed all-pairs tables of this graph,
+  // without running a search. The same routes, though maybe not in the
+  // same order.
+  std::vector<std::shared_ptr<Waypoint>>
+  searchAll(Vertex *start, Vertex *destination, SearchCriteria criteria,
+            const AllPairsTable &table, int limit = -1,
+            SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    std::vector<std::shared_ptr<Waypoint>> allPaths;
+    if (!contains(start) || !contains(destination)) {
+      return allPaths;
+    }
 
-    // Now do a complete search to find ALL paths with the same optimal cost
-    // Using DFS to explore all possible paths
-    Stack<std::shared_ptr<Waypoint>> frontier;
-    std::shared_ptr<Waypoint> first = std::make_shared<Waypoint>(start);
-    frontier.push(first);
+    const CompactGraph &compact = freeze();
+    if (table.version != compact.version || !table.has(criteria)) {
+      throw std::logic_error("All-pairs tables are out of date");
+    }
+    timer.frozen();
+
+    std::vector<std::vector<int>> routes =
+        table.allPathArcs(compact, start->id, destination->id, criteria,
+                          limit);
+    SearchStats lookup;
+    lookup.bytes = table.bytes();
+    timer.searched(lookup);
+    for (const std::vector<int> &arcs : routes) {
+      allPaths.push_back(pathFromArcs(start->id, arcs, criteria));
+    }
+    timer.built();
+    return allPaths;
+  }
 
-    while (!frontier.isEmpty()) {
-      std::shared_ptr<Waypoint> current = frontier.pop();
+  // Find Route's answer: every tied optimal itinerary, from table when it
+  // is given and matches the graph and from a search otherwise. Answers
+  // are kept in a bounded LRU cache tagged with the graph's version, so a
+  // repeated query is a lookup until the graph next changes.
+  std::vector<std::shared_ptr<Waypoint>>
+  findRoutes(Vertex *start, Vertex *destination, SearchCriteria criteria,
+             const AllPairsTable *table = nullptr,
+             SearchStats *stats = nullptr) {
+    if (!contains(start) || !contains(destination)) {
+      return std::vector<std::shared_ptr<Waypoint>>();
+    }
 
-      // If we've exceeded the optimal cost, skip this path
-      if (current->partialCost > optimalCost) {
-        continue;
-      }
+    QueryKey key = {start->id, destination->id, criteria, 0};
+    const std::vector<std::shared_ptr<Waypoint>> *cached =
+        queryCache.find(key, version);
+    if (cached != nullptr) {
+      PhaseTimer timer(stats);
+      timer.searched(SearchStats());
+      return *cached;
+    }
 
-      // If we reached the destination with optimal cost
-      if (current->vertex == destination &&
-          current->partialCost == optimalCost) {
-        // Check if this is a different path (not already in allPaths)
-        bool isDuplicate = false;
-        for (const auto &existingPath : allPaths) {
-          if (isSamePath(current, existingPath)) {
-            isDuplicate = true;
-            break;
-          }
-        }
-        if (!isDuplicate) {
-          allPaths.push_back(current);
-        }
-        continue;
-      }
+    std::vector<std::shared_ptr<Waypoint>> routes;
+    if (table != nullptr && table->version == version &&
+        table->has(criteria)) {
+      routes = searchAll(start, destination, criteria, *table, -1, stats);
+    } else {
+      routes = searchAll(start, destination, criteria, -1, stats);
+    }
+    queryCache.insert(key, routes, version);
+    return routes;
+  }
 
-      // Expand children
-      std::vector<std::shared_ptr<Waypoint>> children =
-          current->expand(criteria);
-
-      for (auto &child : children) {
-        // Avoid cycles: check if vertex is already in current path
-        bool inCurrentPath = false;
-        std::shared_ptr<Waypoint> pathCheck = current;
-        while (pathCheck != nullptr) {
-          if (pathCheck->vertex == child->vertex) {
-            inCurrentPath = true;
-            break;
-          }
-          pathCheck = pathCheck->parent;
-        }
+  // Hit, miss and eviction counts of the findRoutes() and
+  // searchConstrained() cache
+  const QueryCache &routeCache() const { return queryCache; }
+
+  // Number of optimal paths searchAll would list, without building them.
+  // Quick unless zero-weight legs tie airports in a cycle, when the routes
+  // are counted one by one.
+  unsigned long long countOptimalPaths(Vertex *start, Vertex *destination,
+                                       SearchCriteria criteria,
+                                       SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    if (!contains(start) || !contains(destination)) {
+      return 0;
+    }
 
-        if (!inCurrentPath && child->partialCost <= optimalCost) {
-          frontier.push(child);
-        }
-      }
+    const CompactGraph &compact = freeze();
+    timer.frozen();
+    if (!routeExists(start, destination, timer)) {
+      return 0;
     }
+    PastTarget goal = {&engine, destination->id, UNREACHABLE};
+    engine.runUntil(compact, start->id, criteria, goal);
+    lastSettled = engine.settledVertices();
+    OptimalPaths optimal(compact, engine, start->id, destination->id,
+                         criteria);
+    unsigned long long count = optimal.count();
+    timer.searched(engine.stats());
+    return count;
+  }
 
-    return allPaths;
+  // Every itinerary not beaten on cost, time and stops at once by another,
+  // cheapest first. Use it instead of running search() once per criteria.
+  std::vector<std::shared_ptr<Waypoint>>
+  searchPareto(Vertex *start, Vertex *destination,
+               SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    std::vector<std::shared_ptr<Waypoint>> front;
+    if (!contains(start) || !contains(destination)) {
+      return front;
+    }
+
+    const CompactGraph &compact = freeze();
+    timer.frozen();
+    if (!routeExists(start, destination, timer)) {
+      return front;
+    }
+    paretoEngine.run(compact, start->id, destination->id);
+    timer.searched(paretoEngine.stats());
+    for (int label : paretoEngine.frontLabels()) {
+      front.push_back(pathFromArcs(start->id, paretoEngine.pathArcs(label),
+                                   CHEAPEST));
+    }
+    timer.built();
+    return front;
+  }
+
+  // Up to k cheapest routes that never visit an airport twice, best first.
+  // Unlike searchAll the routes need not tie; threads workers share the
+  // detour searches of each route.
+  std::vector<std::shared_ptr<Waypoint>>
+  kShortest(Vertex *start, Vertex *destination, SearchCriteria criteria, int k,
+            int threads = 1, SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    std::vector<std::shared_ptr<Waypoint>> routes;
+    if (!contains(start) || !contains(destination)) {
+      return routes;
+    }
+
+    const CompactGraph &compact = freeze();
+    timer.frozen();
+    if (!routeExists(start, destination, timer)) {
+      return routes;
+    }
+    yen.run(compact, start->id, destination->id, criteria, k, threads);
+    timer.searched(yen.stats());
+    for (const KShortestPaths::Path &path : yen.paths()) {
+      routes.push_back(pathFromArcs(start->id, path.arcs, criteria));
+    }
+    timer.built();
+    return routes;
+  }
+
+  // Lengths of the best routes from every airport in sources to every
+  // airport in targets: row i, column j is sources[i] -> targets[j], and
+  // UNREACHABLE where there is no route or the airport is not in the graph.
+  // The one-to-many searches run on threads workers.
+  DistanceTable distanceTable(const std::vector<Vertex *> &sources,
+                              const std::vector<Vertex *> &targets,
+                              SearchCriteria criteria,
+                              int threads = defaultThreads(),
+                              SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    const CompactGraph &compact = freeze();
+    timer.frozen();
+
+    std::vector<int> from;
+    std::vector<int> to;
+    for (Vertex *v : sources) {
+      from.push_back(contains(v) ? v->id : -1);
+    }
+    for (Vertex *v : targets) {
+      to.push_back(contains(v) ? v->id : -1);
+    }
+
+    DistanceTable table = tableEngine.run(compact, from, to, criteria, threads);
+    timer.searched(tableEngine.stats());
+    return table;
+  }
+
+  // Round trip from home through every airport in stops, in the order that
+  // makes it shortest under criteria: one itinerary per leg, starting and
+  // ending at home. The order is exact for up to EXACT_TOUR_LIMIT stops and
+  // found by local search beyond. Empty if an airport is not in the graph
+  // or some stop cannot be reached and left.
+  std::vector<std::shared_ptr<Waypoint>>
+  planTour(Vertex *home, const std::vector<Vertex *> &stops,
+           SearchCriteria criteria, int threads = defaultThreads(),
+           SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    std::vector<std::shared_ptr<Waypoint>> legs;
+    std::vector<int> ids(1, contains(home) ? home->id : -1);
+    for (Vertex *v : stops) {
+      ids.push_back(contains(v) ? v->id : -1);
+    }
+    if (std::find(ids.begin(), ids.end(), -1) != ids.end()) {
+      return legs;
+    }
+
+    const CompactGraph &compact = freeze();
+    timer.frozen();
+    DistanceTable table = tableEngine.run(compact, ids, ids, criteria, threads);
+    Tour tour = tourEngine.solve(table, threads);
+    SearchStats work = tableEngine.stats();
+    work += tourEngine.stats();
+    timer.searched(work);
+    if (tour.length == UNREACHABLE) {
+      return legs;
+    }
+
+    // Stitch the legs from home, through the stops, back home
+    tour.order.push_back(0);
+    int at = 0;
+    for (int next : tour.order) {
+      engine.run(compact, ids[at], ids[next], criteria);
+      legs.push_back(
+          pathFromArcs(ids[at], engine.pathArcs(ids[next]), criteria));
+      at = next;
+    }
+    timer.built();
+    return legs;
+  }
+
+  // Earliest-arrival journey on a timetable of this graph's airports for a
+  // traveller at start from time departure on: the connections ridden, in
+  // travel order, or none if destination cannot be reached (or is start)
+  std::vector<int> earliestArrival(Vertex *start, Vertex *destination,
+                                   int departure, const Timetable &tt,
+                                   SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    if (!contains(start) || !contains(destination)) {
+      return std::vector<int>();
+    }
+    if (tt.stationCount() != vertices.size()) {
+      throw std::logic_error("Timetable is not for this graph's airports");
+    }
+    timer.frozen();
+
+    scanEngine.run(tt, start->id, departure, destination->id);
+    timer.searched(scanEngine.stats());
+    std::vector<int> legs = scanEngine.journey(tt, destination->id);
+    timer.built();
+    return legs;
+  }
+
+  // Trade-off between arrival time and changes of plane on a route
+  // timetable of this graph's airports: for each number of transfers up to
+  // maxTransfers that arrives earlier than with fewer, that arrival
+  std::vector<RaptorArrival> arrivalsByTransfers(Vertex *start,
+                                                 Vertex *destination,
+                                                 int departure,
+                                                 const RouteTimetable &rt,
+                                                 int maxTransfers = 4,
+                                                 SearchStats *stats = nullptr) {
+    PhaseTimer timer(stats);
+    if (!contains(start) || !contains(destination)) {
+      return std::vector<RaptorArrival>();
+    }
+    if (rt.stationCount() != vertices.size()) {
+      throw std::logic_error("Timetable is not for this graph's airports");
+    }
+    timer.frozen();
+
+    raptorEngine.run(rt, start->id, departure, maxTransfers, destination->id);
+    timer.searched(raptorEngine.stats());
+    return raptorEngine.arrivals(destination->id);
   }
 
 private:
-  // Helper to check if two paths are the same
-  bool isSamePath(const std::shared_ptr<Waypoint> &p1,
-                  const std::shared_ptr<Waypoint> &p2) {
-    std::shared_ptr<Waypoint> c1 = p1;
-    std::shared_ptr<Waypoint> c2 = p2;
-
-    while (c1 != nullptr && c2 != nullptr) {
-      if (c1->vertex != c2->vertex) {
-        return false;
-      }
-      c1 = c1->parent;
-      c2 = c2->parent;
+  CompactGraph snapshot;
+  Dijkstra engine;
+  BidirectionalDijkstra pairEngine;
+  DirectionOptimizingBfs stopsEngine;
+  ParetoSearch paretoEngine;
+  ConstrainedSearch budgetEngine;
+  KShortestPaths yen;
+  ManyToMany tableEngine;
+  TourPlanner tourEngine;
+  ConnectionScan scanEngine;
+  Raptor raptorEngine;
+  QueryCache queryCache = QueryCache(QUERY_CACHE_SIZE);
+  std::vector<DynamicTree> trees; // kept by searchCached()
+  int nextTree = 0;                // slot searchCached() refills next
+  LabelArena labels;
+  std::vector<int> frontier; // label indices, for bfs() and dfs()
+  int lastSettled = 0;
+
+  Reachability reachIndex; // see reachability()
+
+  // False, with the query recorded as settling nothing, when the
+  // reachability index rules out every route from start to destination
+  bool routeExists(Vertex *start, Vertex *destination, PhaseTimer &timer) {
+    if (reachability().canReach(start->id, destination->id)) {
+      return true;
     }
+    lastSettled = 0;
+    timer.searched(SearchStats());
+    return false;
+  }
 
-    return (c1 == nullptr && c2 == nullptr);
+  // Ends a bfs() or dfs() whose search produced work, turning label found
+  // (-1 if none) into the answer
+  std::shared_ptr<Waypoint> finishLabelSearch(Vertex *start, int found,
+                                              SearchStats &work,
+                                              PhaseTimer &timer) {
+    lastSettled = work.settled;
+    work.bytes = labels.bytes() + frontier.capacity() * sizeof(int) +
+                 snapshot.vertexCount() / 8;
+    timer.searched(work);
+    if (found == -1) {
+      return nullptr;
+    }
+    std::shared_ptr<Waypoint> result =
+        pathFromArcs(start->id, labels.pathArcs(found), CHEAPEST);
+    timer.built();
+    return result;
+  }
+
+  // Ends a search run by engine, building the answer from its tree
+  std::shared_ptr<Waypoint> finishEngineSearch(Vertex *start,
+                                               Vertex *destination,
+                                               SearchCriteria criteria,
+                                               PhaseTimer &timer) {
+    lastSettled = engine.settledVertices();
+    timer.searched(engine.stats());
+    if (!engine.settled(destination->id)) {
+      return nullptr;
+    }
+    std::shared_ptr<Waypoint> result =
+        pathFromArcs(start->id, engine.pathArcs(destination->id), criteria);
+    timer.built();
+    return result;
   }
 };
 
@@ -0,0 +1,146 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <stdexcept>
+#include <vector>
+
+// Min-priority queue over the dense ids 0..n-1 with decrease-key.
+// Every id is stored at most once and position[] remembers where it sits in
+// the D-ary heap, so lowering a key is a sift-up instead of a linear scan.
+template <class K, int D = 4> class IndexedHeap {
+  std::vector<int> heap;
+  std::vector<int> position;
+  std::vector<K> keys;
+
+  void place(int slot, int id) {
+    heap[slot] = id;
+    position[id] = slot;
+  }
+
+  void siftUp(int slot) {
+    int id = heap[slot];
+    while (slot > 0) {
+      int parent = (slot - 1) / D;
+      if (!(keys[id] < keys[heap[parent]])) {
+        break;
+      }
+      place(slot, heap[parent]);
+      slot = parent;
+    }
+    place(slot, id);
+  }
+
+  void siftDown(int slot) {
+    int id = heap[slot];
+    int count = heap.size();
+    while (true) {
+      int first = slot * D + 1;
+      if (first >= count) {
+        break;
+      }
+      int best = first;
+      int last = first + D < count ? first + D : count;
+      for (int c = first + 1; c < last; c++) {
+        if (keys[heap[c]] < keys[heap[best]]) {
+          best = c;
+        }
+      }
+      if (!(keys[heap[best]] < keys[id])) {
+        break;
+      }
+      place(slot, heap[best]);
+      slot = best;
+    }
+    place(slot, id);
+  }
+
+public:
+  IndexedHeap(int n = 0) { resize(n); }
+
+  // Makes room for ids 0..n-1. The heap must be empty.
+  void resize(int n) {
+    if (!heap.empty()) {
+      throw std::logic_error("Cannot resize a non-empty heap");
+    }
+    position.assign(n, -1);
+    keys.resize(n);
+  }
+
+  int capacity() const { return position.size(); }
+
+  int size() const { return heap.size(); }
+
+  // Storage held by the heap, including spare capacity
+  std::size_t bytes() const {
+    return (heap.capacity() + position.capacity()) * sizeof(int) +
+           keys.capacity() * sizeof(K);
+  }
+
+  bool isEmpty() const { return heap.empty(); }
+
+  bool contains(int id) const { return position[id] != -1; }
+
+  const K &key(int id) const { return keys[id]; }
+
+  void push(int id, K key) {
+    if (contains(id)) {
+      throw std::logic_error("Id is already in the heap");
+    }
+    keys[id] = key;
+    heap.push_back(id);
+    siftUp(heap.size() - 1);
+  }
+
+  void decreaseKey(int id, K key) {
+    if (!contains(id)) {
+      throw std::logic_error("Id is not in the heap");
+    }
+    keys[id] = key;
+    siftUp(position[id]);
+  }
+
+  // Inserts id, or lowers its key if it is already queued with a larger one.
+  // Returns false when the heap already held an equal or better key.
+  bool pushOrDecrease(int id, K key) {
+    if (!contains(id)) {
+      push(id, key);
+      return true;
+    }
+    if (key < keys[id]) {
+      decreaseKey(id, key);
+      return true;
+    }
+    return false;
+  }
+
+  int top() const {
+    if (heap.empty()) {
+      throw std::logic_error("Heap is empty");
+    }
+    return heap[0];
+  }
+
+  const K &topKey() const { return keys[top()]; }
+
+  int pop() {
+    int id = top();
+    int last = heap.back();
+    heap.pop_back();
+    position[id] = -1;
+    if (!heap.empty()) {
+      place(0, last);
+      siftDown(0);
+    }
+    return id;
+  }
+
+  // Empties the heap in O(size), leaving the id range untouched.
+  void clear() {
+    for (int id : heap) {
+      position[id] = -1;
+    }
+    heap.clear();
+  }
+};
+
+#endif
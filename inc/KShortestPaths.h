@@ -0,0 +1,149 @@
+#ifndef K_SHORTEST_PATHS_H
+#define K_SHORTEST_PATHS_H
+
+#include <CompactGraph.h>
+#include <Dijkstra.h>
+#include <Parallel.h>
+#include <SearchStats.h>
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+// The k shortest loopless paths between two vertices (Yen's algorithm).
+// Each accepted path P is split at every vertex v_i: the candidate keeps
+// P's first i arcs (the root) and finishes with a shortest v_i-target path
+// (the spur) that avoids the root's vertices and the next arc of every
+// accepted path sharing that root. The cheapest candidate becomes the next
+// path. Spurs only start at or after the vertex where P left the path it
+// was derived from (Lawler), since earlier spurs were already tried.
+// Spur searches reuse one Dijkstra engine and one blocked set per worker
+// instead of copying the graph, and the spurs of a path run in parallel.
+class KShortestPaths {
+public:
+  struct Path {
+    int cost;
+    std::vector<int> arcs;
+    int deviation; // index of the first arc not shared with its parent
+
+    Path(int cost = UNREACHABLE, std::vector<int> arcs = std::vector<int>(),
+         int deviation = 0) {
+      this->cost = cost;
+      this->arcs = arcs;
+      this->deviation = deviation;
+    }
+  };
+
+private:
+  std::vector<Dijkstra> engines;
+  std::vector<Blocked> blocked;
+  std::vector<SearchStats> workerStats;
+  std::vector<Path> found;
+  SearchStats work;
+
+  // Candidate from the spur at position i of path, cost UNREACHABLE if the
+  // blocked graph has no spur
+  Path spur(const CompactGraph &g, int source, int target,
+            SearchCriteria criteria, const Path &path, int i, int worker) {
+    Dijkstra &engine = engines[worker];
+    Blocked &avoid = blocked[worker];
+    avoid.reset(g.vertexCount(), g.arcCount());
+
+    int from = source;
+    int rootCost = 0;
+    for (int j = 0; j < i; j++) {
+      avoid.blockVertex(from);
+      rootCost += g.weight(path.arcs[j], criteria);
+      from = g.targets[path.arcs[j]];
+    }
+    for (const Path &other : found) {
+      if ((int)other.arcs.size() > i &&
+          std::equal(path.arcs.begin(), path.arcs.begin() + i,
+                     other.arcs.begin())) {
+        avoid.blockArc(other.arcs[i]);
+      }
+    }
+
+    SilentTrace trace;
+    engine.run(g, from, target, criteria, trace, NoPotential(), avoid);
+    workerStats[worker] += engine.stats();
+    if (!engine.reached(target)) {
+      return Path();
+    }
+
+    std::vector<int> arcs(path.arcs.begin(), path.arcs.begin() + i);
+    for (int arc : engine.pathArcs(target)) {
+      arcs.push_back(arc);
+    }
+    return Path(rootCost + engine.distance(target), arcs, i);
+  }
+
+public:
+  // Finds up to k shortest loopless source-target paths, cheapest first,
+  // running the spur searches of each path on up to threads workers
+  const std::vector<Path> &run(const CompactGraph &g, int source, int target,
+                               SearchCriteria criteria, int k,
+                               int threads = 1) {
+    found.clear();
+    work.clear();
+    if (k <= 0) {
+      return found;
+    }
+    threads = std::max(1, threads);
+    engines.resize(threads);
+    blocked.resize(threads);
+    workerStats.assign(threads, SearchStats());
+
+    engines[0].run(g, source, target, criteria);
+    work += engines[0].stats();
+    if (!engines[0].reached(target)) {
+      return found;
+    }
+    found.push_back(Path(engines[0].distance(target),
+                         engines[0].pathArcs(target), 0));
+
+    // Deviation index of each candidate, ordered by cost, then arcs, which
+    // also merges a candidate reached from two different parents
+    std::map<std::pair<int, std::vector<int>>, int> candidates;
+    while ((int)found.size() < k) {
+      const Path last = found.back();
+      int first = last.deviation;
+      int count = last.arcs.size() - first;
+
+      std::vector<Path> spurs(std::max(count, 0));
+      parallelFor(count, threads, [&](int i, int worker) {
+        spurs[i] = spur(g, source, target, criteria, last, first + i, worker);
+      });
+
+      for (const Path &p : spurs) {
+        if (p.cost == UNREACHABLE) {
+          continue;
+        }
+        std::pair<int, std::vector<int>> key(p.cost, p.arcs);
+        if (!candidates.count(key) || p.deviation < candidates[key]) {
+          candidates[key] = p.deviation;
+        }
+      }
+      if (candidates.empty()) {
+        break;
+      }
+
+      found.push_back(Path(candidates.begin()->first.first,
+                           candidates.begin()->first.second,
+                           candidates.begin()->second));
+      candidates.erase(candidates.begin());
+    }
+
+    for (const SearchStats &w : workerStats) {
+      work += w;
+    }
+    return found;
+  }
+
+  const std::vector<Path> &paths() const { return found; }
+
+  // Counters of the last run, summed over every spur search
+  const SearchStats &stats() const { return work; }
+};
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// Bounded map that forgets its least recently used entry when full.
+// Entries are tagged with the version of the data they were computed
+// from, and a lookup with any other version drops the entry instead of
+// returning it, so a stale answer is never served.
+// Entries sit in one array and the recency list links them by index, so
+// the cache can be copied along with its owner.
+template <class K, class V, class Hash = std::hash<K>> class LRUCache {
+  struct Slot {
+    K key;
+    V value;
+    long version;
+    int prev; // more recently used slot, -1 at the front
+    int next; // less recently used slot, -1 at the back
+  };
+
+  std::vector<Slot> slots;
+  std::unordered_map<K, int, Hash> index;
+  std::vector<int> spare; // slots freed by stale entries
+  int front;
+  int back;
+  int limit;
+  long hitCount;
+  long missCount;
+  long evictionCount;
+
+  void unlink(int i) {
+    Slot &s = slots[i];
+    (s.prev == -1 ? front : slots[s.prev].next) = s.next;
+    (s.next == -1 ? back : slots[s.next].prev) = s.prev;
+  }
+
+  void pushFront(int i) {
+    slots[i].prev = -1;
+    slots[i].next = front;
+    (front == -1 ? back : slots[front].prev) = i;
+    front = i;
+  }
+
+public:
+  LRUCache(int capacity = 128) {
+    limit = capacity > 0 ? capacity : 1;
+    front = -1;
+    back = -1;
+    hitCount = 0;
+    missCount = 0;
+    evictionCount = 0;
+  }
+
+  // The value cached for key at version, nullptr if there is none. The
+  // pointer is valid until the next insert or clear.
+  const V *find(const K &key, long version) {
+    typename std::unordered_map<K, int, Hash>::iterator it = index.find(key);
+    if (it == index.end()) {
+      missCount++;
+      return nullptr;
+    }
+    int i = it->second;
+    if (slots[i].version != version) {
+      unlink(i);
+      spare.push_back(i);
+      index.erase(it);
+      missCount++;
+      return nullptr;
+    }
+    unlink(i);
+    pushFront(i);
+    hitCount++;
+    return &slots[i].value;
+  }
+
+  // Caches value for key at version, evicting the least recently used
+  // entry if the cache is full
+  void insert(const K &key, const V &value, long version) {
+    typename std::unordered_map<K, int, Hash>::iterator it = index.find(key);
+    int i;
+    if (it != index.end()) {
+      i = it->second;
+      unlink(i);
+    } else if (!spare.empty()) {
+      i = spare.back();
+      spare.pop_back();
+    } else if ((int)slots.size() < limit) {
+      i = slots.size();
+      slots.push_back(Slot{key, value, version, -1, -1});
+    } else {
+      i = back;
+      unlink(i);
+      index.erase(slots[i].key);
+      evictionCount++;
+    }
+    slots[i].key = key;
+    slots[i].value = value;
+    slots[i].version = version;
+    index[key] = i;
+    pushFront(i);
+  }
+
+  // Drops every entry; the counters keep running
+  void clear() {
+    slots.clear();
+    index.clear();
+    spare.clear();
+    front = -1;
+    back = -1;
+  }
+
+  int size() const { return index.size(); }
+
+  int capacity() const { return limit; }
+
+  long hits() const { return hitCount; }
+
+  long misses() const { return missCount; }
+
+  // Entries dropped to make room, not counting stale ones
+  long evictions() const { return evictionCount; }
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef LABEL_ARENA_H
+#define LABEL_ARENA_H
+
+#include <CompactGraph.h>
+#include <algorithm>
+#include <vector>
+
+// Partial itinerary of a search: how it reached vertex and what it cost
+struct SearchLabel {
+  int parent; // index of the label this one extends, -1 at the source
+  int vertex;
+  int arc; // arc taken from the parent's vertex, -1 at the source
+  int cost;
+  int time;
+  int stops;
+};
+
+// Per-query pool of search labels. Labels refer to their parents by index,
+// so creating one is a push into a contiguous array with no reference
+// counting, and clear() drops a whole query's labels at once while keeping
+// the storage for the next query. Only the labels of a final answer are
+// turned into Waypoint chains, via pathArcs().
+class LabelArena {
+  std::vector<SearchLabel> labels;
+
+public:
+  void clear() { labels.clear(); }
+
+  int size() const { return labels.size(); }
+
+  const SearchLabel &operator[](int i) const { return labels[i]; }
+
+  // Starts an itinerary at vertex and returns its label
+  int root(int vertex) {
+    labels.push_back(SearchLabel{-1, vertex, -1, 0, 0, 0});
+    return labels.size() - 1;
+  }
+
+  // Extends label parent along arc of g and returns the new label
+  int extend(int parent, int arc, const CompactGraph &g) {
+    SearchLabel from = labels[parent];
+    labels.push_back(SearchLabel{parent, g.targets[arc], arc,
+                                 from.cost + g.costs[arc],
+                                 from.time + g.durations[arc],
+                                 from.stops + 1});
+    return labels.size() - 1;
+  }
+
+  // Arcs of the itinerary ending in label, in travel order
+  std::vector<int> pathArcs(int label) const {
+    std::vector<int> arcs;
+    for (int l = label; labels[l].parent != -1; l = labels[l].parent) {
+      arcs.push_back(labels[l].arc);
+    }
+    std::reverse(arcs.begin(), arcs.end());
+    return arcs;
+  }
+
+  // Storage held by the arena, including spare capacity
+  std::size_t bytes() const { return labels.capacity() * sizeof(SearchLabel); }
+};
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include <CompactGraph.h>
+#include <Dijkstra.h>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Landmark distance tables for ALT (A*, landmarks, triangle inequality).
+// For a handful of landmarks L the exact distances d(L, v) and d(v, L) are
+// stored for every vertex v and criteria. By the triangle inequality
+//   d(v, t) >= d(L, t) - d(L, v)   and   d(v, t) >= d(v, L) - d(t, L),
+// so the largest of these over all landmarks bounds the remaining cost of
+// any criteria, fares included, where map geometry says little.
+// Tables are vertex-major so evaluating one vertex reads one small block.
+class Landmarks {
+  int n;
+  int k;
+  std::vector<int> chosen;
+  std::vector<int> fromLandmark[3]; // d(L, v) at [v * k + l]
+  std::vector<int> toLandmark[3];   // d(v, L) at [v * k + l]
+
+  // Picks landmarks farthest-first by flight count: each new landmark is
+  // the vertex farthest from all landmarks chosen so far, with unreachable
+  // vertices counting as farthest so every component gets covered
+  void select(const CompactGraph &g, int count) {
+    Dijkstra engine;
+    std::vector<long> nearest(n, (long)UNREACHABLE + 1);
+
+    engine.run(g, 0, -1, LEAST_STOPS);
+    int next = 0;
+    for (int v = 0; v < n; v++) {
+      if (engine.distance(v) != UNREACHABLE &&
+          engine.distance(v) > engine.distance(next)) {
+        next = v;
+      }
+    }
+
+    while ((int)chosen.size() < count) {
+      chosen.push_back(next);
+      engine.run(g, next, -1, LEAST_STOPS);
+      for (int v = 0; v < n; v++) {
+        nearest[v] = std::min(nearest[v], (long)engine.distance(v));
+      }
+      for (int v = 0; v < n; v++) {
+        if (nearest[v] > nearest[next]) {
+          next = v;
+        }
+      }
+      if (nearest[next] == 0) {
+        break;
+      }
+    }
+  }
+
+  void fill(const CompactGraph &g) {
+    CompactGraph reverse = g.reversed();
+    Dijkstra engine;
+    SearchCriteria modes[] = {CHEAPEST, FASTEST, LEAST_STOPS};
+    for (SearchCriteria mode : modes) {
+      fromLandmark[mode].assign((long)n * k, UNREACHABLE);
+      toLandmark[mode].assign((long)n * k, UNREACHABLE);
+      for (int l = 0; l < k; l++) {
+        engine.run(g, chosen[l], -1, mode);
+        for (int v = 0; v < n; v++) {
+          fromLandmark[mode][(long)v * k + l] = engine.distance(v);
+        }
+        engine.run(reverse, chosen[l], -1, mode);
+        for (int v = 0; v < n; v++) {
+          toLandmark[mode][(long)v * k + l] = engine.distance(v);
+        }
+      }
+    }
+  }
+
+  // Cheap fingerprint of the adjacency, so stored tables are only loaded
+  // for the graph they were computed on
+  static unsigned long signature(const CompactGraph &g) {
+    unsigned long h = 14695981039346656037ul;
+    for (int arc = 0; arc < g.arcCount(); arc++) {
+      h = (h ^ (unsigned long)g.targets[arc]) * 1099511628211ul;
+      h = (h ^ (unsigned long)g.costs[arc]) * 1099511628211ul;
+      h = (h ^ (unsigned long)g.durations[arc]) * 1099511628211ul;
+    }
+    for (int u = 0; u <= g.vertexCount(); u++) {
+      h = (h ^ (unsigned long)g.offsets[u]) * 1099511628211ul;
+    }
+    return h;
+  }
+
+public:
+  // Graph::version of the snapshot the tables belong to, -1 if empty
+  long version;
+
+  Landmarks() {
+    n = 0;
+    k = 0;
+    version = -1;
+  }
+
+  Landmarks(const CompactGraph &g, int count = 16) {
+    n = g.vertexCount();
+    k = 0;
+    version = g.version;
+    if (n == 0) {
+      return;
+    }
+    select(g, std::min(count, n));
+    k = chosen.size();
+    fill(g);
+  }
+
+  int count() const { return k; }
+
+  int landmark(int l) const { return chosen[l]; }
+
+  // Lower bound on d(v, target) under criteria, UNREACHABLE when the tables
+  // prove v cannot reach target at all
+  int bound(int v, int target, SearchCriteria criteria) const {
+    const int *fromV = &fromLandmark[criteria][(long)v * k];
+    const int *fromT = &fromLandmark[criteria][(long)target * k];
+    const int *toV = &toLandmark[criteria][(long)v * k];
+    const int *toT = &toLandmark[criteria][(long)target * k];
+
+    int best = 0;
+    for (int l = 0; l < k; l++) {
+      // L reaches v but not target, or target reaches L but v does not
+      if ((fromV[l] != UNREACHABLE && fromT[l] == UNREACHABLE) ||
+          (toT[l] != UNREACHABLE && toV[l] == UNREACHABLE)) {
+        return UNREACHABLE;
+      }
+      if (fromV[l] != UNREACHABLE && fromT[l] != UNREACHABLE) {
+        best = std::max(best, fromT[l] - fromV[l]);
+      }
+      if (toV[l] != UNREACHABLE && toT[l] != UNREACHABLE) {
+        best = std::max(best, toV[l] - toT[l]);
+      }
+    }
+    return best;
+  }
+
+  // Writes the tables as text, tagged with the graph's fingerprint
+  void save(std::ostream &os, const CompactGraph &g) const {
+    os << "landmarks " << n << " " << k << " " << signature(g) << "\n";
+    for (int l = 0; l < k; l++) {
+      os << chosen[l] << (l + 1 < k ? " " : "\n");
+    }
+    for (int c = 0; c < 3; c++) {
+      for (const std::vector<int> *table : {&fromLandmark[c], &toLandmark[c]}) {
+        for (std::size_t i = 0; i < table->size(); i++) {
+          os << (*table)[i] << ((i + 1) % k == 0 ? "\n" : " ");
+        }
+      }
+    }
+  }
+
+  // Reads tables written by save(). Returns false, leaving this object
+  // unchanged, if they were computed for a different graph or are damaged.
+  bool load(std::istream &is, const CompactGraph &g) {
+    std::string tag;
+    int vertices;
+    int count;
+    unsigned long stored;
+    if (!(is >> tag >> vertices >> count >> stored) || tag != "landmarks" ||
+        vertices != g.vertexCount() || stored != signature(g) ||
+        count <= 0 || count > vertices) {
+      return false;
+    }
+
+    Landmarks loaded;
+    loaded.n = vertices;
+    loaded.k = count;
+    loaded.chosen.assign(count, 0);
+    for (int l = 0; l < count; l++) {
+      if (!(is >> loaded.chosen[l]) || loaded.chosen[l] < 0 ||
+          loaded.chosen[l] >= vertices) {
+        return false;
+      }
+    }
+    for (int c = 0; c < 3; c++) {
+      for (std::vector<int> *table :
+           {&loaded.fromLandmark[c], &loaded.toLandmark[c]}) {
+        table->assign((long)vertices * count, 0);
+        for (std::size_t i = 0; i < table->size(); i++) {
+          is >> (*table)[i];
+        }
+      }
+    }
+    if (!is) {
+      return false;
+    }
+
+    loaded.version = g.version;
+    *this = loaded;
+    return true;
+  }
+};
+
+// A* potential from landmark tables
+struct LandmarkPotential {
+  const Landmarks *landmarks;
+  int target;
+  SearchCriteria criteria;
+
+  LandmarkPotential(const Landmarks &landmarks, int target,
+                    SearchCriteria criteria) {
+    this->landmarks = &landmarks;
+    this->target = target;
+    this->criteria = criteria;
+  }
+
+  int operator()(int v) const {
+    return landmarks->bound(v, target, criteria);
+  }
+};
+
+#endif
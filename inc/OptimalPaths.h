@@ -0,0 +1,194 @@
+#ifndef OPTIMAL_PATHS_H
+#define OPTIMAL_PATHS_H
+
+#include <CompactGraph.h>
+#include <Dijkstra.h>
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+// Goal of a search feeding OptimalPaths: it keeps settling after the
+// target until the first vertex farther away, so every vertex tied with
+// the target (through zero-weight arcs, say) has its final distance too
+struct PastTarget {
+  const Dijkstra *engine;
+  int target;
+  int bound;
+
+  bool operator()(int u) {
+    if (u == target) {
+      bound = engine->distance(u);
+    }
+    return bound != UNREACHABLE && engine->distance(u) > bound;
+  }
+};
+
+// Every optimal source-target route of a Dijkstra run. An arc u -> v is
+// tight when dist(u) + w = dist(v), and a simple path costs dist(target)
+// exactly when all its arcs are tight, so the optimal routes are the
+// simple source-target paths over tight arcs, as searchAll has always
+// listed them. Zero-weight arcs can close cycles of tight arcs; listing
+// backtracks from the target and never revisits a vertex on the path.
+// Without such a cycle the tight arcs form a DAG and counting is one pass
+// over it in topological order; with one, count() lists the simple paths
+// to count them.
+class OptimalPaths {
+  int source;
+  int target;
+  struct TightArc {
+    int arc;
+    int tail;
+  };
+
+  std::vector<int> vertices; // vertices on some tight path into the target
+  std::vector<std::vector<TightArc>> into;
+  std::vector<unsigned long long> ways;
+  bool acyclic;
+
+  // Calls visit(arcs) on each simple path, arcs from the target back,
+  // until it returns false
+  template <class Visit> void backtrack(Visit visit) const {
+    if (vertices.empty()) {
+      return;
+    }
+
+    // choice[d] indexes the arc taken at depth d
+    std::vector<bool> onPath(into.size(), false);
+    std::vector<int> at(1, target);
+    std::vector<int> choice(1, 0);
+    std::vector<int> arcs;
+    onPath[target] = true;
+    while (!at.empty()) {
+      int v = at.back();
+      if (v == source && !visit(arcs)) {
+        return;
+      }
+      if (v == source || choice.back() == (int)into[v].size()) {
+        onPath[v] = false;
+        at.pop_back();
+        choice.pop_back();
+        if (!arcs.empty()) {
+          arcs.pop_back();
+        }
+        if (!choice.empty()) {
+          choice.back()++;
+        }
+        continue;
+      }
+      const TightArc &t = into[v][choice.back()];
+      if (onPath[t.tail]) {
+        choice.back()++;
+        continue;
+      }
+      onPath[t.tail] = true;
+      arcs.push_back(t.arc);
+      at.push_back(t.tail);
+      choice.push_back(0);
+    }
+  }
+
+public:
+  // engine must hold a run from source that settled target and everything
+  // as near as it, such as one stopped by PastTarget
+  OptimalPaths(const CompactGraph &g, const Dijkstra &engine, int source,
+               int target, SearchCriteria criteria) {
+    this->source = source;
+    this->target = target;
+    acyclic = true;
+    int n = g.vertexCount();
+    into.assign(n, std::vector<TightArc>());
+    ways.assign(n, 0);
+    if (!engine.settled(target)) {
+      return;
+    }
+
+    // Walk back from the target over tight arcs
+    std::vector<bool> seen(n, false);
+    std::vector<int> stack(1, target);
+    seen[target] = true;
+    while (!stack.empty()) {
+      int v = stack.back();
+      stack.pop_back();
+      vertices.push_back(v);
+      if (v == source) {
+        continue;
+      }
+
+      for (int i = g.inBegin(v); i < g.inEnd(v); i++) {
+        int u = g.sources[i];
+        int arc = g.inArcs[i];
+        if (!engine.settled(u) ||
+            engine.distance(u) + g.weight(arc, criteria) !=
+                engine.distance(v)) {
+          continue;
+        }
+        into[v].push_back(TightArc{arc, u});
+        if (!seen[u]) {
+          seen[u] = true;
+          stack.push_back(u);
+        }
+      }
+
+      // List the engine's own tree arc first so the first path enumerated
+      // is the one a plain search returns
+      std::vector<TightArc> &arcs = into[v];
+      for (std::size_t i = 1; i < arcs.size(); i++) {
+        if (arcs[i].arc == engine.arcTo(v)) {
+          std::swap(arcs[0], arcs[i]);
+        }
+      }
+    }
+
+    // Kahn's order from the source; a vertex left over sits on a cycle
+    std::vector<int> pending(n, 0);
+    std::vector<std::vector<int>> out(n);
+    for (int v : vertices) {
+      pending[v] = into[v].size();
+      for (const TightArc &t : into[v]) {
+        out[t.tail].push_back(v);
+      }
+    }
+    std::vector<int> order(1, source);
+    ways[source] = 1;
+    for (std::size_t i = 0; i < order.size(); i++) {
+      int u = order[i];
+      for (int v : out[u]) {
+        unsigned long long sum = ways[v] + ways[u];
+        ways[v] = sum < ways[v] ? ULLONG_MAX : sum;
+        if (--pending[v] == 0) {
+          order.push_back(v);
+        }
+      }
+    }
+    acyclic = order.size() == vertices.size();
+  }
+
+  // Number of simple optimal paths, the ones enumerate() lists, saturating
+  // at ULLONG_MAX. Exponential when zero-weight arcs close a cycle of ties.
+  unsigned long long count() const {
+    if (acyclic) {
+      return ways[target];
+    }
+    unsigned long long paths = 0;
+    backtrack([&paths](const std::vector<int> &) {
+      return ++paths != ULLONG_MAX;
+    });
+    return paths;
+  }
+
+  // Up to limit optimal paths (all of them when limit is negative), each
+  // as arcs in travel order
+  std::vector<std::vector<int>> enumerate(int limit = -1) const {
+    std::vector<std::vector<int>> paths;
+    if (limit == 0) {
+      return paths;
+    }
+    backtrack([&paths, limit](const std::vector<int> &arcs) {
+      paths.push_back(std::vector<int>(arcs.rbegin(), arcs.rend()));
+      return (int)paths.size() != limit;
+    });
+    return paths;
+  }
+};
+
+#endif
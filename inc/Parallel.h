@@ -0,0 +1,42 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Worker count to use when the caller does not choose one
+inline int defaultThreads() {
+  int cores = std::thread::hardware_concurrency();
+  return cores > 0 ? cores : 1;
+}
+
+// Calls body(i, worker) for every i in [0, count) on up to threads workers.
+// Workers pull the next index from a shared counter, so uneven tasks still
+// balance, and worker (0..threads-1) lets the body pick per-thread scratch
+// space. With one worker everything runs on the calling thread.
+template <class Body> void parallelFor(int count, int threads, Body body) {
+  threads = std::max(1, std::min(threads, count));
+  if (threads <= 1) {
+    for (int i = 0; i < count; i++) {
+      body(i, 0);
+    }
+    return;
+  }
+
+  std::atomic<int> next(0);
+  std::vector<std::thread> workers;
+  for (int w = 0; w < threads; w++) {
+    workers.push_back(std::thread([&next, &body, count, w]() {
+      for (int i = next++; i < count; i = next++) {
+        body(i, w);
+      }
+    }));
+  }
+  for (std::thread &t : workers) {
+    t.join();
+  }
+}
+
+#endif
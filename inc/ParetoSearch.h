@@ -0,0 +1,185 @@
+#ifndef PARETO_SEARCH_H
+#define PARETO_SEARCH_H
+
+#include <CompactGraph.h>
+#include <SearchStats.h>
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <vector>
+
+// Multi-criteria label-setting search (Martins) over (cost, time, stops).
+// Each vertex keeps a bag of mutually non-dominated labels; a label is kept
+// only if no label already at its vertex, or at the target, is at least as
+// good in all three. Labels leave the queue in lexicographic order, which
+// makes each one final when popped, and the target's bag at the end is the
+// Pareto front of itineraries.
+// Labels live in one flat array indexed by position and each bag is a small
+// contiguous array of (cost, time, stops, label) records, so dominance
+// checks scan packed integers instead of following pointers.
+class ParetoSearch {
+public:
+  struct Label {
+    int cost;
+    int time;
+    int stops;
+    int vertex;
+    int parent; // label this one extends, -1 at the source
+    int arc;    // arc taken from the parent's vertex
+    bool dead;  // removed from its bag by a dominating label
+  };
+
+private:
+  struct BagEntry {
+    int cost;
+    int time;
+    int stops;
+    int label;
+
+    bool dominates(int c, int t, int s) const {
+      return cost <= c && time <= t && stops <= s;
+    }
+  };
+
+  struct QueueEntry {
+    int cost;
+    int time;
+    int stops;
+    int label;
+
+    bool operator>(const QueueEntry &other) const {
+      if (cost != other.cost) {
+        return cost > other.cost;
+      }
+      if (time != other.time) {
+        return time > other.time;
+      }
+      if (stops != other.stops) {
+        return stops > other.stops;
+      }
+      return label > other.label;
+    }
+  };
+
+  std::vector<Label> labels;
+  std::vector<std::vector<BagEntry>> bags;
+  std::vector<int> touched;
+  std::vector<int> front;
+  SearchStats work;
+
+  static bool dominated(const std::vector<BagEntry> &bag, int c, int t,
+                        int s) {
+    for (const BagEntry &e : bag) {
+      if (e.dominates(c, t, s)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Adds a label to v's bag, evicting the entries it dominates
+  void insert(int v, int label) {
+    const Label &l = labels[label];
+    std::vector<BagEntry> &bag = bags[v];
+    if (bag.empty()) {
+      touched.push_back(v);
+    }
+
+    int kept = 0;
+    for (std::size_t i = 0; i < bag.size(); i++) {
+      const BagEntry &e = bag[i];
+      if (l.cost <= e.cost && l.time <= e.time && l.stops <= e.stops) {
+        labels[e.label].dead = true;
+      } else {
+        bag[kept++] = e;
+      }
+    }
+    bag.resize(kept);
+    bag.push_back(BagEntry{l.cost, l.time, l.stops, label});
+  }
+
+public:
+  // Computes the Pareto front of source-target itineraries
+  void run(const CompactGraph &g, int source, int target) {
+    for (int v : touched) {
+      bags[v].clear();
+    }
+    touched.clear();
+    labels.clear();
+    front.clear();
+    work.clear();
+    if ((int)bags.size() != g.vertexCount()) {
+      bags.assign(g.vertexCount(), std::vector<BagEntry>());
+    }
+
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+                        std::greater<QueueEntry>>
+        queue;
+    labels.push_back(Label{0, 0, 0, source, -1, -1, false});
+    insert(source, 0);
+    queue.push(QueueEntry{0, 0, 0, 0});
+    work.pushed(1);
+
+    while (!queue.empty()) {
+      QueueEntry top = queue.top();
+      queue.pop();
+      work.pops++;
+      if (labels[top.label].dead) {
+        continue;
+      }
+      work.settled++;
+
+      int u = labels[top.label].vertex;
+      if (u == target) {
+        front.push_back(top.label);
+        continue;
+      }
+
+      for (int arc = g.begin(u); arc < g.end(u); arc++) {
+        int v = g.targets[arc];
+        int c = top.cost + g.costs[arc];
+        int t = top.time + g.durations[arc];
+        int s = top.stops + 1;
+        work.relaxed++;
+        if (dominated(bags[target], c, t, s) || dominated(bags[v], c, t, s)) {
+          continue;
+        }
+
+        labels.push_back(Label{c, t, s, v, top.label, arc, false});
+        int label = labels.size() - 1;
+        insert(v, label);
+        queue.push(QueueEntry{c, t, s, label});
+        work.pushed(queue.size());
+      }
+    }
+
+    work.bytes = labels.capacity() * sizeof(Label) +
+                 work.peakFrontier * sizeof(QueueEntry);
+    for (int v : touched) {
+      work.bytes += bags[v].capacity() * sizeof(BagEntry);
+    }
+  }
+
+  // Target labels of the front, cheapest first
+  const std::vector<int> &frontLabels() const { return front; }
+
+  const Label &label(int i) const { return labels[i]; }
+
+  // Arcs of the itinerary ending in label, in travel order
+  std::vector<int> pathArcs(int label) const {
+    std::vector<int> arcs;
+    for (int l = label; labels[l].parent != -1; l = labels[l].parent) {
+      arcs.push_back(labels[l].arc);
+    }
+    std::reverse(arcs.begin(), arcs.end());
+    return arcs;
+  }
+
+  // Labels created by the last run
+  int labelCount() const { return labels.size(); }
+
+  // Counters of the last run; settled counts labels made final
+  const SearchStats &stats() const { return work; }
+};
+
+#endif
@@ -0,0 +1,325 @@
+#ifndef RAPTOR_H
+#define RAPTOR_H
+
+#include <Bitset.h>
+#include <Dijkstra.h>
+#include <Parallel.h>
+#include <RouteTimetable.h>
+#include <SearchStats.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+// One journey of a RAPTOR answer: leave at departure, arrive at arrival,
+// changing planes transfers times
+struct RaptorArrival {
+  int departure;
+  int arrival;
+  int transfers;
+
+  RaptorArrival(int departure, int arrival, int transfers) {
+    this->departure = departure;
+    this->arrival = arrival;
+    this->transfers = transfers;
+  }
+};
+
+// Round-based public transit routing (Delling, Pajor & Werneck) on a
+// RouteTimetable. Round k finds the earliest arrival at every station
+// using k trips: each route serving a station improved in round k - 1 is
+// scanned once from its first such stop, hopping on the earliest trip that
+// can be caught there and off wherever it arrives earlier than known. One
+// query therefore yields the Pareto set of (arrival, transfers) at every
+// station. Arrival times live in one flat array per round and routes are
+// scanned in place, with no priority queue.
+// rangeQuery() is rRAPTOR: it runs the departures of a time window latest
+// first, keeping the arrays between them, since a journey that leaves
+// later bounds the ones that leave earlier. Disjoint slices of the window
+// run on separate workers.
+class Raptor {
+  // Per-round labels at [k * n + s]: the earliest arrival at s using at
+  // most k trips, and the route, trip and stop positions of the last trip,
+  // with route -1 when round k merely kept round k - 1's arrival
+  struct Rounds {
+    std::vector<int> arrival;
+    std::vector<int> route;
+    std::vector<int> trip;
+    std::vector<int> boardAt;
+    std::vector<int> alightAt;
+    std::vector<int> firstStop; // per route, -1 if not queued
+    std::vector<int> queued;
+    Bitset marked;
+    SearchStats work;
+
+    void reset(int n, int routes, int rounds) {
+      arrival.assign((long)rounds * n, UNREACHABLE);
+      route.assign((long)rounds * n, -1);
+      trip.assign((long)rounds * n, -1);
+      boardAt.assign((long)rounds * n, -1);
+      alightAt.assign((long)rounds * n, -1);
+      firstStop.assign(routes, -1);
+      queued.clear();
+      marked.resize(n);
+      work.clear();
+    }
+  };
+
+  int rounds;
+  int origin;
+  std::vector<Rounds> workers;
+  SearchStats work;
+
+  // Runs the rounds for one departure from source, on top of whatever w
+  // already holds from later departures
+  void scan(const RouteTimetable &rt, Rounds &w, int source, int departure,
+            int target) {
+    int n = rt.stationCount();
+    w.marked.clear();
+    if (departure < w.arrival[source]) {
+      w.arrival[source] = departure;
+      w.marked.set(source);
+    }
+
+    for (int k = 1; k < rounds; k++) {
+      int *now = &w.arrival[(long)k * n];
+      const int *before = &w.arrival[(long)(k - 1) * n];
+      for (int s = 0; s < n; s++) {
+        if (before[s] < now[s]) {
+          now[s] = before[s];
+          w.route[(long)k * n + s] = -1;
+        }
+      }
+
+      // Queue each route once, from its earliest marked stop
+      for (int word = 0; word < w.marked.wordCount(); word++) {
+        std::uint64_t bits = w.marked.word(word);
+        while (bits != 0) {
+          int s = word * 64 + __builtin_ctzll(bits);
+          bits &= bits - 1;
+          for (int i = rt.servedFrom(s); i < rt.servedTo(s); i++) {
+            int r = rt.servedRouteAt(i);
+            int p = rt.servedPositionAt(i);
+            if (w.firstStop[r] == -1) {
+              w.queued.push_back(r);
+              w.firstStop[r] = p;
+            } else {
+              w.firstStop[r] = std::min(w.firstStop[r], p);
+            }
+          }
+        }
+      }
+      w.marked.clear();
+      if (w.queued.empty()) {
+        break;
+      }
+
+      for (int r : w.queued) {
+        scanRoute(rt, w, r, k, source, target);
+        w.firstStop[r] = -1;
+      }
+      w.queued.clear();
+    }
+  }
+
+  void scanRoute(const RouteTimetable &rt, Rounds &w, int r, int k,
+                 int source, int target) {
+    int n = rt.stationCount();
+    int *now = &w.arrival[(long)k * n];
+    const int *before = &w.arrival[(long)(k - 1) * n];
+    int t = -1;
+    int board = -1;
+    w.work.pops++;
+
+    for (int p = w.firstStop[r]; p < rt.stopCount(r); p++) {
+      int s = rt.stop(r, p);
+      w.work.relaxed++;
+      if (t != -1) {
+        int a = rt.arrival(r, t, p);
+        int bound = target == -1 ? now[s] : std::min(now[s], now[target]);
+        if (a < bound) {
+          long at = (long)k * n + s;
+          now[s] = a;
+          w.route[at] = r;
+          w.trip[at] = t;
+          w.boardAt[at] = board;
+          w.alightAt[at] = p;
+          w.marked.set(s);
+          w.work.settled++;
+        }
+      }
+
+      // An earlier trip can be caught here after arriving in round k - 1
+      if (before[s] != UNREACHABLE) {
+        int ready = before[s] + (s == source ? 0 : rt.layover(s));
+        int limit = t == -1 ? rt.tripCount(r) : t;
+        int earlier = rt.earliestTrip(r, p, ready, limit);
+        if (earlier < limit) {
+          t = earlier;
+          board = p;
+        }
+      }
+    }
+  }
+
+  // Arrivals at target that use fewer trips than any earlier arrival
+  void collect(const Rounds &w, int n, int departure, int target,
+               std::vector<RaptorArrival> &out) const {
+    for (int k = 1; k < rounds; k++) {
+      int a = w.arrival[(long)k * n + target];
+      if (a < w.arrival[(long)(k - 1) * n + target]) {
+        out.push_back(RaptorArrival(departure, a, k - 1));
+      }
+    }
+  }
+
+public:
+  Raptor() {
+    rounds = 0;
+    origin = -1;
+  }
+
+  // Earliest arrivals at every station with 0..maxTransfers changes for a
+  // traveller at source from time departure on. When target is given,
+  // arrivals later than the best one at target are not pursued.
+  void run(const RouteTimetable &rt, int source, int departure,
+           int maxTransfers = 4, int target = -1) {
+    rounds = maxTransfers + 2;
+    origin = source;
+    workers.resize(1);
+    Rounds &w = workers[0];
+    w.reset(rt.stationCount(), rt.routeCount(), rounds);
+    scan(rt, w, source, departure, target);
+    work = w.work;
+    work.bytes = rt.bytes() + 5 * w.arrival.size() * sizeof(int);
+  }
+
+  // Pareto set of (arrival, transfers) at target after run(), fewest
+  // transfers first and each arriving earlier than the one before
+  std::vector<RaptorArrival> arrivals(int target) const {
+    std::vector<RaptorArrival> out;
+    const Rounds &w = workers[0];
+    int n = w.marked.size();
+    collect(w, n, w.arrival[origin], target, out);
+    return out;
+  }
+
+  // Connections ridden to reach target with transfers changes after run(),
+  // in travel order; empty if run() found no such journey
+  std::vector<int> journey(const RouteTimetable &rt, int target,
+                           int transfers) const {
+    std::vector<int> legs;
+    const Rounds &w = workers[0];
+    int n = rt.stationCount();
+    int k = transfers + 1;
+    if (k >= rounds || w.arrival[(long)k * n + target] == UNREACHABLE) {
+      return legs;
+    }
+
+    int s = target;
+    while (k > 0) {
+      long at = (long)k * n + s;
+      if (w.route[at] == -1) {
+        k--;
+        continue;
+      }
+      for (int p = w.alightAt[at] - 1; p >= w.boardAt[at]; p--) {
+        legs.push_back(rt.leg(w.route[at], w.trip[at], p));
+      }
+      s = rt.stop(w.route[at], w.boardAt[at]);
+      k--;
+    }
+    std::reverse(legs.begin(), legs.end());
+    return legs;
+  }
+
+  // rRAPTOR: the journeys to target leaving source between from and to,
+  // keeping only those no other journey beats by leaving no earlier,
+  // arriving no later and changing no more often. Sorted by departure,
+  // then transfers. The departures are split among threads workers.
+  std::vector<RaptorArrival> rangeQuery(const RouteTimetable &rt, int source,
+                                        int target, int from, int to,
+                                        int maxTransfers = 4,
+                                        int threads = 1) {
+    rounds = maxTransfers + 2;
+    origin = source;
+    int n = rt.stationCount();
+
+    // Every time a trip leaves source inside the window, latest first
+    std::vector<int> times;
+    for (int i = rt.servedFrom(source); i < rt.servedTo(source); i++) {
+      int r = rt.servedRouteAt(i);
+      int p = rt.servedPositionAt(i);
+      for (int t = 0; t < rt.tripCount(r); t++) {
+        int d = rt.departure(r, t, p);
+        if (d >= from && d <= to && p + 1 < rt.stopCount(r)) {
+          times.push_back(d);
+        }
+      }
+    }
+    std::sort(times.begin(), times.end(), std::greater<int>());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+
+    int slices = std::max(1, std::min(threads, (int)times.size()));
+    workers.resize(slices);
+    std::vector<std::vector<RaptorArrival>> found(slices);
+    // A worker may run several slices, and reset() clears its counters
+    std::vector<SearchStats> counted(slices);
+    parallelFor(slices, slices, [&](int slice, int worker) {
+      Rounds &w = workers[worker];
+      w.reset(n, rt.routeCount(), rounds);
+      int first = (long)times.size() * slice / slices;
+      int last = (long)times.size() * (slice + 1) / slices;
+      for (int i = first; i < last; i++) {
+        scan(rt, w, source, times[i], target);
+        collect(w, n, times[i], target, found[slice]);
+      }
+      counted[slice] = w.work;
+    });
+
+    work.clear();
+    std::vector<RaptorArrival> all;
+    for (int slice = 0; slice < slices; slice++) {
+      work += counted[slice];
+      all.insert(all.end(), found[slice].begin(), found[slice].end());
+    }
+    work.bytes = rt.bytes() + slices * 5 * (long)rounds * n * sizeof(int);
+
+    // Latest departure first, so each entry is checked against all the
+    // entries that could dominate it
+    std::sort(all.begin(), all.end(),
+              [](const RaptorArrival &a, const RaptorArrival &b) {
+                if (a.departure != b.departure) {
+                  return a.departure > b.departure;
+                }
+                if (a.transfers != b.transfers) {
+                  return a.transfers < b.transfers;
+                }
+                return a.arrival < b.arrival;
+              });
+    std::vector<int> best(rounds, UNREACHABLE);
+    std::vector<RaptorArrival> profile;
+    for (const RaptorArrival &a : all) {
+      if (best[a.transfers] <= a.arrival) {
+        continue;
+      }
+      profile.push_back(a);
+      for (int k = a.transfers; k < rounds; k++) {
+        best[k] = std::min(best[k], a.arrival);
+      }
+    }
+    std::sort(profile.begin(), profile.end(),
+              [](const RaptorArrival &a, const RaptorArrival &b) {
+                if (a.departure != b.departure) {
+                  return a.departure < b.departure;
+                }
+                return a.transfers < b.transfers;
+              });
+    return profile;
+  }
+
+  // Counters of the last query; pops count route scans and relaxed the
+  // stops visited along them
+  const SearchStats &stats() const { return work; }
+};
+
+#endif
@@ -0,0 +1,222 @@
+#ifndef REACHABILITY_H
+#define REACHABILITY_H
+
+#include <CompactGraph.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Above this many components the closure (components^2 / 8 bytes) is not
+// built and canReach() cannot rule any pair out
+const int CLOSURE_LIMIT = 16384;
+
+// Answers "is there any route from u to v" in constant time.
+// Tarjan's algorithm groups the vertices into strongly connected
+// components, whose members all reach each other. Tarjan numbers the
+// components so that arcs between them only lead to lower numbers, so one
+// pass upward gives each component the bitset of components it reaches by
+// OR-ing the rows of its successors into its own.
+// New vertices and arcs update the rows in place: an arc u -> v that adds
+// reachability lets every component reaching u reach all that v reaches.
+// Components are not merged when such an arc closes a cycle, so they may
+// then be finer than the true strongly connected components; canReach()
+// stays exact.
+class Reachability {
+  std::vector<int> comp; // component of each vertex
+  int count;
+  int stride;                      // words per row
+  std::vector<std::uint64_t> rows; // row c: the components c reaches
+  bool closed;                     // false above CLOSURE_LIMIT
+
+  void setBit(int c, int d) {
+    rows[(long)c * stride + (d >> 6)] |= std::uint64_t(1) << (d & 63);
+  }
+
+  bool bit(int c, int d) const {
+    return (rows[(long)c * stride + (d >> 6)] >> (d & 63)) & 1;
+  }
+
+  // rows[c] |= rows[d]
+  void merge(int c, int d) {
+    std::uint64_t *to = &rows[(long)c * stride];
+    const std::uint64_t *from = &rows[(long)d * stride];
+    for (int i = 0; i < stride; i++) {
+      to[i] |= from[i];
+    }
+  }
+
+  // Iterative Tarjan over g, filling comp and count
+  void findComponents(const CompactGraph &g) {
+    int n = g.vertexCount();
+    comp.assign(n, -1);
+    count = 0;
+    std::vector<int> index(n, -1);
+    std::vector<int> low(n);
+    std::vector<int> nextArc(n);
+    std::vector<int> stack;
+    std::vector<int> path; // the DFS call stack
+    int counter = 0;
+
+    for (int s = 0; s < n; s++) {
+      if (index[s] != -1) {
+        continue;
+      }
+      index[s] = low[s] = counter++;
+      nextArc[s] = g.begin(s);
+      stack.push_back(s);
+      path.push_back(s);
+
+      while (!path.empty()) {
+        int u = path.back();
+        if (nextArc[u] < g.end(u)) {
+          int v = g.targets[nextArc[u]++];
+          if (index[v] == -1) {
+            index[v] = low[v] = counter++;
+            nextArc[v] = g.begin(v);
+            stack.push_back(v);
+            path.push_back(v);
+          } else if (comp[v] == -1) {
+            // Still on the stack, so in u's component
+            low[u] = std::min(low[u], index[v]);
+          }
+          continue;
+        }
+
+        path.pop_back();
+        if (!path.empty()) {
+          low[path.back()] = std::min(low[path.back()], low[u]);
+        }
+        if (low[u] == index[u]) {
+          int w;
+          do {
+            w = stack.back();
+            stack.pop_back();
+            comp[w] = count;
+          } while (w != u);
+          count++;
+        }
+      }
+    }
+  }
+
+public:
+  // Graph::version the index matches, -1 if never built
+  long version;
+
+  Reachability() {
+    count = 0;
+    stride = 0;
+    closed = true;
+    version = -1;
+  }
+
+  // Computes the components and their closure from scratch
+  void build(const CompactGraph &g) {
+    findComponents(g);
+    version = g.version;
+    closed = count <= CLOSURE_LIMIT;
+    stride = closed ? (count + 63) / 64 : 0;
+    rows.assign((long)count * stride, 0);
+    if (!closed) {
+      return;
+    }
+
+    // Members of each component, grouped by counting sort
+    int n = g.vertexCount();
+    std::vector<int> first(count + 1, 0);
+    for (int v = 0; v < n; v++) {
+      first[comp[v] + 1]++;
+    }
+    for (int c = 0; c < count; c++) {
+      first[c + 1] += first[c];
+    }
+    std::vector<int> members(n);
+    std::vector<int> fill(first.begin(), first.end() - 1);
+    for (int v = 0; v < n; v++) {
+      members[fill[comp[v]]++] = v;
+    }
+
+    // Successors have lower numbers, so their rows are final
+    std::vector<int> mergedInto(count, -1);
+    for (int c = 0; c < count; c++) {
+      setBit(c, c);
+      for (int i = first[c]; i < first[c + 1]; i++) {
+        int u = members[i];
+        for (int arc = g.begin(u); arc < g.end(u); arc++) {
+          int d = comp[g.targets[arc]];
+          if (d != c && mergedInto[d] != c) {
+            mergedInto[d] = c;
+            merge(c, d);
+          }
+        }
+      }
+    }
+  }
+
+  // Adds vertex vertexCount() with no arcs
+  void addVertex() {
+    comp.push_back(count++);
+    if (!closed) {
+      return;
+    }
+    if (count > CLOSURE_LIMIT) {
+      closed = false;
+      rows.clear();
+      stride = 0;
+      return;
+    }
+
+    // Widen the rows when the new component needs another word
+    int words = (count + 63) / 64;
+    if (words > stride) {
+      int wider = std::max(words, 2 * stride);
+      std::vector<std::uint64_t> grown((long)count * wider, 0);
+      for (int c = 0; c < count - 1; c++) {
+        std::copy(rows.begin() + (long)c * stride,
+                  rows.begin() + (long)(c + 1) * stride,
+                  grown.begin() + (long)c * wider);
+      }
+      rows.swap(grown);
+      stride = wider;
+    } else {
+      rows.resize((long)count * stride, 0);
+    }
+    setBit(count - 1, count - 1);
+  }
+
+  // Records a new arc u -> v
+  void addArc(int u, int v) {
+    if (!closed || canReach(u, v)) {
+      return;
+    }
+    int cu = comp[u];
+    int cv = comp[v];
+    for (int c = 0; c < count; c++) {
+      if (bit(c, cu)) {
+        merge(c, cv);
+      }
+    }
+  }
+
+  // True if some path leads from u to v, and always from u to u. Without
+  // the closure every pair is answered true, so callers search as before.
+  bool canReach(int u, int v) const {
+    return comp[u] == comp[v] || !closed || bit(comp[u], comp[v]);
+  }
+
+  bool hasClosure() const { return closed; }
+
+  int vertexCount() const { return comp.size(); }
+
+  int componentCount() const { return count; }
+
+  int componentOf(int v) const { return comp[v]; }
+
+  std::size_t bytes() const {
+    return comp.capacity() * sizeof(int) +
+           rows.capacity() * sizeof(std::uint64_t);
+  }
+};
+
+#endif
@@ -0,0 +1,216 @@
+#ifndef ROUTE_TIMETABLE_H
+#define ROUTE_TIMETABLE_H
+
+#include <Timetable.h>
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+// A Timetable regrouped into routes for round-based searches. A route is a
+// sequence of stations served by trips that all stop at exactly those
+// stations in that order and never overtake each other, so at every stop
+// the route's trips leave in the same order. Each route keeps its trips'
+// times as one trip-major block of departures and arrivals, and each
+// station lists the (route, position) pairs that serve it.
+class RouteTimetable {
+  // Legs of the trips that make up one route
+  typedef std::vector<const std::vector<int> *> Members;
+
+  int stations;
+  std::vector<int> layovers;
+
+  std::vector<int> stopBegin; // route r's stations are stops[stopBegin[r]..]
+  std::vector<int> stops;
+  std::vector<int> trips;     // trips of each route
+  std::vector<int> timeBegin; // trip t, position p of r at timeBegin[r] +
+                              // t * stopCount(r) + p
+  std::vector<int> departures;
+  std::vector<int> arrivals;
+  std::vector<int> legs; // connection leaving position p, -1 at the end
+
+  std::vector<int> servedBegin; // station s is served at [servedBegin[s]..)
+  std::vector<int> servedRoute;
+  std::vector<int> servedPosition;
+
+  // True if trip b (connection indices) leaves and arrives no earlier than
+  // trip a at every stop
+  static bool follows(const Timetable &tt, const std::vector<int> &a,
+                      const std::vector<int> &b) {
+    for (std::size_t i = 0; i < a.size(); i++) {
+      if (tt[b[i]].departure < tt[a[i]].departure ||
+          tt[b[i]].arrival < tt[a[i]].arrival) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void addRoute(const Timetable &tt, const Members &members) {
+    const std::vector<int> &first = *members[0];
+    int length = first.size() + 1;
+    stops.push_back(tt[first[0]].from);
+    for (int c : first) {
+      stops.push_back(tt[c].to);
+    }
+    stopBegin.push_back(stops.size());
+    trips.push_back(members.size());
+    timeBegin.push_back(departures.size());
+
+    for (const std::vector<int> *trip : members) {
+      for (int p = 0; p < length; p++) {
+        bool last = p == length - 1;
+        const Connection &in = tt[(*trip)[p == 0 ? 0 : p - 1]];
+        const Connection &out = tt[(*trip)[last ? p - 1 : p]];
+        arrivals.push_back(p == 0 ? out.departure : in.arrival);
+        departures.push_back(last ? in.arrival : out.departure);
+        legs.push_back(last ? -1 : (*trip)[p]);
+      }
+    }
+  }
+
+public:
+  // Groups the trips of a sorted timetable into routes. Throws if the legs
+  // of a trip do not form a chain of stations.
+  RouteTimetable(const Timetable &tt) {
+    if (!tt.isSorted()) {
+      throw std::logic_error("Timetable must be sorted before grouping");
+    }
+    stations = tt.stationCount();
+    for (int s = 0; s < stations; s++) {
+      layovers.push_back(tt.layover(s));
+    }
+    stopBegin.push_back(0);
+
+    // Legs of each trip, in order since the timetable is sorted
+    std::vector<std::vector<int>> tripLegs(tt.tripCount());
+    for (int i = 0; i < tt.connectionCount(); i++) {
+      std::vector<int> &trip = tripLegs[tt[i].trip];
+      if (!trip.empty() && tt[trip.back()].to != tt[i].from) {
+        throw std::logic_error("Trip legs do not form a chain of stations");
+      }
+      trip.push_back(i);
+    }
+
+    std::vector<int> order;
+    for (int t = 0; t < tt.tripCount(); t++) {
+      if (!tripLegs[t].empty()) {
+        order.push_back(t);
+      }
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+      return tt[tripLegs[a][0]].departure < tt[tripLegs[b][0]].departure;
+    });
+
+    // Trips by stop sequence, each split into routes that do not overtake
+    std::map<std::vector<int>, std::vector<Members>> routes;
+    for (int t : order) {
+      const std::vector<int> &trip = tripLegs[t];
+      std::vector<int> sequence(1, tt[trip[0]].from);
+      for (int c : trip) {
+        sequence.push_back(tt[c].to);
+      }
+      std::vector<Members> &candidates = routes[sequence];
+      bool placed = false;
+      for (Members &route : candidates) {
+        if (follows(tt, *route.back(), trip)) {
+          route.push_back(&trip);
+          placed = true;
+          break;
+        }
+      }
+      if (!placed) {
+        candidates.push_back(Members(1, &trip));
+      }
+    }
+    for (auto &entry : routes) {
+      for (const Members &members : entry.second) {
+        addRoute(tt, members);
+      }
+    }
+
+    // Counting sort of (route, position) pairs by station
+    servedBegin.assign(stations + 1, 0);
+    for (int s : stops) {
+      servedBegin[s + 1]++;
+    }
+    for (int s = 0; s < stations; s++) {
+      servedBegin[s + 1] += servedBegin[s];
+    }
+    std::vector<int> fill(servedBegin.begin(), servedBegin.end() - 1);
+    servedRoute.assign(stops.size(), 0);
+    servedPosition.assign(stops.size(), 0);
+    for (int r = 0; r < routeCount(); r++) {
+      for (int p = 0; p < stopCount(r); p++) {
+        int slot = fill[stop(r, p)]++;
+        servedRoute[slot] = r;
+        servedPosition[slot] = p;
+      }
+    }
+  }
+
+  int stationCount() const { return stations; }
+
+  int layover(int station) const { return layovers[station]; }
+
+  int routeCount() const { return trips.size(); }
+
+  int stopCount(int route) const {
+    return stopBegin[route + 1] - stopBegin[route];
+  }
+
+  int tripCount(int route) const { return trips[route]; }
+
+  int stop(int route, int position) const {
+    return stops[stopBegin[route] + position];
+  }
+
+  int departure(int route, int trip, int position) const {
+    return departures[timeBegin[route] + trip * stopCount(route) + position];
+  }
+
+  int arrival(int route, int trip, int position) const {
+    return arrivals[timeBegin[route] + trip * stopCount(route) + position];
+  }
+
+  // Timetable connection a trip rides from position to the next stop
+  int leg(int route, int trip, int position) const {
+    return legs[timeBegin[route] + trip * stopCount(route) + position];
+  }
+
+  // Earliest trip of route leaving position at or after time among trips
+  // 0..limit-1, limit if there is none
+  int earliestTrip(int route, int position, int time, int limit) const {
+    int low = 0;
+    int high = limit;
+    while (low < high) {
+      int mid = (low + high) / 2;
+      if (departure(route, mid, position) < time) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low;
+  }
+
+  // Range of station's entries in servedRoute and servedPosition
+  int servedFrom(int station) const { return servedBegin[station]; }
+
+  int servedTo(int station) const { return servedBegin[station + 1]; }
+
+  int servedRouteAt(int i) const { return servedRoute[i]; }
+
+  int servedPositionAt(int i) const { return servedPosition[i]; }
+
+  std::size_t bytes() const {
+    return (layovers.size() + stopBegin.size() + stops.size() + trips.size() +
+            timeBegin.size() + departures.size() + arrivals.size() +
+            legs.size() + servedBegin.size() + servedRoute.size() +
+            servedPosition.size()) *
+           sizeof(int);
+  }
+};
+
+#endif
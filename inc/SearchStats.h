@@ -0,0 +1,129 @@
+#ifndef SEARCH_STATS_H
+#define SEARCH_STATS_H
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <string>
+
+// Work done by a search. Engines count the frontier operations as they go,
+// and Graph's entry points add the wall time of each phase of a query:
+// freezing the snapshot, searching, and building the Waypoint answer.
+// Stats of many queries add up with +=, where peaks take the maximum.
+struct SearchStats {
+  long queries;
+  long settled;      // vertices whose distance became final
+  long relaxed;      // arcs examined
+  long pushes;       // frontier insertions
+  long pops;         // frontier removals
+  long decreaseKeys; // frontier key improvements
+  long peakFrontier; // largest frontier size seen
+  long bytes;        // memory held by the search's working arrays
+  double freezeMs;
+  double searchMs;
+  double pathMs;
+
+  SearchStats() { clear(); }
+
+  void clear() {
+    queries = 0;
+    settled = 0;
+    relaxed = 0;
+    pushes = 0;
+    pops = 0;
+    decreaseKeys = 0;
+    peakFrontier = 0;
+    bytes = 0;
+    freezeMs = 0;
+    searchMs = 0;
+    pathMs = 0;
+  }
+
+  // Records a frontier insertion that left the frontier holding size entries
+  void pushed(long size) {
+    pushes++;
+    peakFrontier = std::max(peakFrontier, size);
+  }
+
+  double totalMs() const { return freezeMs + searchMs + pathMs; }
+
+  SearchStats &operator+=(const SearchStats &other) {
+    queries += other.queries;
+    settled += other.settled;
+    relaxed += other.relaxed;
+    pushes += other.pushes;
+    pops += other.pops;
+    decreaseKeys += other.decreaseKeys;
+    peakFrontier = std::max(peakFrontier, other.peakFrontier);
+    bytes = std::max(bytes, other.bytes);
+    freezeMs += other.freezeMs;
+    searchMs += other.searchMs;
+    pathMs += other.pathMs;
+    return *this;
+  }
+
+  // Multi-line summary for display
+  std::string summary() const {
+    std::ostringstream os;
+    os << "Settled: " << settled << ", relaxed: " << relaxed << "\n";
+    os << "Heap: " << pushes << " pushes, " << pops << " pops, "
+       << decreaseKeys << " decrease-keys, peak " << peakFrontier << "\n";
+    os << "Memory: " << bytes / 1024 << " KB\n";
+    os.setf(std::ios::fixed);
+    os.precision(3);
+    os << "Time: " << totalMs() << " ms (freeze " << freezeMs << ", search "
+       << searchMs << ", path " << pathMs << ")\n";
+    return os.str();
+  }
+};
+
+// Times the phases of one query into a SearchStats. It does nothing, not
+// even read the clock, when no stats were asked for.
+class PhaseTimer {
+  typedef std::chrono::steady_clock Clock;
+
+  SearchStats *stats;
+  Clock::time_point mark;
+
+  double lap() {
+    Clock::time_point now = Clock::now();
+    double ms = std::chrono::duration<double, std::milli>(now - mark).count();
+    mark = now;
+    return ms;
+  }
+
+public:
+  // Starts a query, resetting stats
+  PhaseTimer(SearchStats *stats) {
+    this->stats = stats;
+    if (stats) {
+      stats->clear();
+      stats->queries = 1;
+      mark = Clock::now();
+    }
+  }
+
+  // Ends the freeze phase
+  void frozen() {
+    if (stats) {
+      stats->freezeMs += lap();
+    }
+  }
+
+  // Ends the search phase, adding the counters of the engine that ran it
+  void searched(const SearchStats &work) {
+    if (stats) {
+      stats->searchMs += lap();
+      *stats += work;
+    }
+  }
+
+  // Ends the phase that builds the answer
+  void built() {
+    if (stats) {
+      stats->pathMs += lap();
+    }
+  }
+};
+
+#endif
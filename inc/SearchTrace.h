@@ -0,0 +1,77 @@
+#ifndef SEARCH_TRACE_H
+#define SEARCH_TRACE_H
+
+#include <vector>
+
+// Search engines report their steps to a trace sink, a class with
+//   void expand(int u);                    // u leaves the frontier
+//   void push(int v, int cost);            // v enters the frontier
+//   void decrease(int v, int was, int now) // v's key improves
+// The sink is a template parameter, so the calls are inlined and a sink
+// with empty methods costs nothing at all.
+
+// Trace that ignores every event, for searches nobody is watching
+struct SilentTrace {
+  void expand(int u) {}
+  void push(int v, int cost) {}
+  void decrease(int v, int was, int now) {}
+};
+
+// One step of a search, as recorded by RingTrace
+struct TraceEvent {
+  enum Kind { EXPAND, PUSH, DECREASE };
+
+  Kind kind;
+  int vertex;
+  int was; // previous key of a DECREASE, else unused
+  int now; // key after a PUSH or DECREASE, else unused
+};
+
+// Trace that keeps the most recent events in a fixed-size ring buffer.
+// Recording is a store into preallocated memory, so tracing a query does
+// not slow it down with I/O, and the steps can be printed afterwards.
+class RingTrace {
+  std::vector<TraceEvent> ring;
+  long recorded;
+
+  void record(TraceEvent::Kind kind, int vertex, int was, int now) {
+    if (ring.empty()) {
+      return;
+    }
+    ring[recorded % ring.size()] = TraceEvent{kind, vertex, was, now};
+    recorded++;
+  }
+
+public:
+  RingTrace(int capacity = 4096) {
+    ring.resize(capacity > 0 ? capacity : 0);
+    recorded = 0;
+  }
+
+  void expand(int u) { record(TraceEvent::EXPAND, u, 0, 0); }
+
+  void push(int v, int cost) { record(TraceEvent::PUSH, v, 0, cost); }
+
+  void decrease(int v, int was, int now) {
+    record(TraceEvent::DECREASE, v, was, now);
+  }
+
+  void clear() { recorded = 0; }
+
+  int capacity() const { return ring.size(); }
+
+  // Events currently held, at most capacity()
+  int size() const {
+    return recorded < (long)ring.size() ? recorded : ring.size();
+  }
+
+  // Events overwritten because the buffer was full
+  long dropped() const { return recorded - size(); }
+
+  // The i-th held event, oldest first
+  const TraceEvent &operator[](int i) const {
+    return ring[(dropped() + i) % ring.size()];
+  }
+};
+
+#endif
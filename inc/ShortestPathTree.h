@@ -0,0 +1,92 @@
+#ifndef SHORTEST_PATH_TREE_H
+#define SHORTEST_PATH_TREE_H
+
+#include <CompactGraph.h>
+#include <Dijkstra.h>
+#include <algorithm>
+#include <vector>
+
+// Goal of a search that stops at the first vertex settled beyond bound.
+// Vertices settle in order of distance, so the ones before it are exactly
+// those within the bound, and they are recorded in that order.
+struct WithinBound {
+  const Dijkstra *engine;
+  int bound;
+  std::vector<int> *order;
+
+  bool operator()(int u) {
+    if (engine->distance(u) > bound) {
+      return true;
+    }
+    order->push_back(u);
+    return false;
+  }
+};
+
+// Everything reachable from a source within a bound on the path length,
+// with each vertex's distance and its parent in the shortest path tree,
+// from one Dijkstra that stops once the bound is passed
+class ShortestPathTree {
+  std::vector<int> dist;   // UNREACHABLE beyond the bound
+  std::vector<int> parent; // -1 for the source and beyond the bound
+  std::vector<int> via;
+
+public:
+  int source;
+  SearchCriteria criteria;
+  int bound;
+  std::vector<int> order; // vertices within the bound, nearest first
+
+  ShortestPathTree() {
+    source = -1;
+    criteria = CHEAPEST;
+    bound = UNREACHABLE;
+  }
+
+  // Grows the tree with engine; bound UNREACHABLE means no bound
+  ShortestPathTree(const CompactGraph &g, Dijkstra &engine, int source,
+                   SearchCriteria criteria, int bound = UNREACHABLE) {
+    this->source = source;
+    this->criteria = criteria;
+    this->bound = bound;
+    int n = g.vertexCount();
+    dist.assign(n, UNREACHABLE);
+    parent.assign(n, -1);
+    via.assign(n, -1);
+
+    WithinBound goal = {&engine, bound, &order};
+    engine.runUntil(g, source, criteria, goal);
+    for (int v : order) {
+      dist[v] = engine.distance(v);
+      parent[v] = engine.parentOf(v);
+      via[v] = engine.arcTo(v);
+    }
+  }
+
+  int size() const { return order.size(); }
+
+  bool contains(int v) const {
+    return v >= 0 && v < (int)dist.size() && dist[v] != UNREACHABLE;
+  }
+
+  int distance(int v) const { return contains(v) ? dist[v] : UNREACHABLE; }
+
+  int parentOf(int v) const { return contains(v) ? parent[v] : -1; }
+
+  int arcTo(int v) const { return contains(v) ? via[v] : -1; }
+
+  // Arcs of the path from the source to v, in travel order
+  std::vector<int> pathArcs(int v) const {
+    std::vector<int> arcs;
+    if (!contains(v)) {
+      return arcs;
+    }
+    for (int u = v; parent[u] != -1; u = parent[u]) {
+      arcs.push_back(via[u]);
+    }
+    std::reverse(arcs.begin(), arcs.end());
+    return arcs;
+  }
+};
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef TIMETABLE_H
+#define TIMETABLE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// One scheduled leg: a trip leaving station from at departure and reaching
+// station to at arrival, both in minutes after midnight of the first day.
+// Consecutive legs of one trip (a through flight) share its trip id, and
+// staying aboard between them needs no layover.
+struct Connection {
+  int from;
+  int to;
+  int departure;
+  int arrival;
+  int trip;
+  int cost;
+
+  Connection(int from, int to, int departure, int arrival, int trip,
+             int cost) {
+    this->from = from;
+    this->to = to;
+    this->departure = departure;
+    this->arrival = arrival;
+    this->trip = trip;
+    this->cost = cost;
+  }
+};
+
+// Schedule of flights between stations 0..n-1, which are a Graph's dense
+// airport ids. Connections are kept in one contiguous array that sort()
+// orders by departure, which is the order timetable searches scan it in.
+// Each station has a minimum layover between arriving on one trip and
+// leaving on another.
+class Timetable {
+  int stations;
+  int trips;
+  bool ordered;
+  std::vector<int> layovers;
+  std::vector<Connection> connections;
+
+public:
+  Timetable(int stations = 0, int layover = 0) {
+    this->stations = stations;
+    trips = 0;
+    ordered = true;
+    layovers.assign(stations, layover);
+  }
+
+  int stationCount() const { return stations; }
+
+  int connectionCount() const { return connections.size(); }
+
+  int tripCount() const { return trips; }
+
+  void setLayover(int station, int minutes) { layovers.at(station) = minutes; }
+
+  int layover(int station) const { return layovers[station]; }
+
+  // Reserves an id for a trip whose legs are added one by one
+  int newTrip() { return trips++; }
+
+  // Adds a leg of trip, or of a new single-leg trip when trip is -1, and
+  // returns the trip id. The timetable must be sorted again before use.
+  // Legs take at least a minute: a leg arriving as it departs could sort
+  // ahead of the leg feeding it, and scans would miss the journey.
+  int addConnection(int from, int to, int departure, int arrival,
+                    int cost = 0, int trip = -1) {
+    if (from < 0 || from >= stations || to < 0 || to >= stations) {
+      throw std::logic_error("Connection between unknown stations");
+    }
+    if (arrival <= departure) {
+      throw std::logic_error("Connection must arrive after it departs");
+    }
+    if (trip >= trips) {
+      throw std::logic_error("Connection on an unknown trip");
+    }
+    if (trip < 0) {
+      trip = newTrip();
+    }
+    connections.push_back(Connection(from, to, departure, arrival, trip, cost));
+    ordered = false;
+    return trip;
+  }
+
+  // Orders connections by departure, earlier arrivals first among ties
+  void sort() {
+    std::stable_sort(connections.begin(), connections.end(),
+                     [](const Connection &a, const Connection &b) {
+                       if (a.departure != b.departure) {
+                         return a.departure < b.departure;
+                       }
+                       return a.arrival < b.arrival;
+                     });
+    ordered = true;
+  }
+
+  bool isSorted() const { return ordered; }
+
+  const Connection &operator[](int i) const { return connections[i]; }
+
+  // Index of the first connection leaving at or after time
+  int firstDeparting(int time) const {
+    return std::lower_bound(connections.begin(), connections.end(), time,
+                            [](const Connection &c, int t) {
+                              return c.departure < t;
+                            }) -
+           connections.begin();
+  }
+
+  std::size_t bytes() const {
+    return connections.capacity() * sizeof(Connection) +
+           layovers.capacity() * sizeof(int);
+  }
+
+  // Minutes after midnight of a "HH:MM" clock time
+  static int parseTime(const std::string &text) {
+    std::size_t colon = text.find(':');
+    if (colon == std::string::npos || colon == 0 ||
+        colon + 3 != text.size()) {
+      throw std::logic_error("Time must be written HH:MM");
+    }
+    for (std::size_t i = 0; i < text.size(); i++) {
+      if (i != colon && (text[i] < '0' || text[i] > '9')) {
+        throw std::logic_error("Time must be written HH:MM");
+      }
+    }
+    int hours = std::stoi(text.substr(0, colon));
+    int minutes = std::stoi(text.substr(colon + 1));
+    if (minutes > 59) {
+      throw std::logic_error("Time must be written HH:MM");
+    }
+    return hours * 60 + minutes;
+  }
+
+  // "HH:MM" of a time, with "+N" for times N days after the first
+  static std::string formatTime(int time) {
+    int days = time / (24 * 60);
+    int hours = time / 60 % 24;
+    int minutes = time % 60;
+    std::string text;
+    text += (char)('0' + hours / 10);
+    text += (char)('0' + hours % 10);
+    text += ':';
+    text += (char)('0' + minutes / 10);
+    text += (char)('0' + minutes % 10);
+    if (days > 0) {
+      text += "+" + std::to_string(days);
+    }
+    return text;
+  }
+};
+
+#endif
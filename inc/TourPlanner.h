@@ -0,0 +1,269 @@
+#ifndef TOUR_PLANNER_H
+#define TOUR_PLANNER_H
+
+#include <Dijkstra.h>
+#include <DistanceTable.h>
+#include <Parallel.h>
+#include <SearchStats.h>
+#include <algorithm>
+#include <vector>
+
+// Tours with up to this many stops besides home are solved exactly
+const int EXACT_TOUR_LIMIT = 15;
+
+// Order in which to visit the stops of a round trip
+struct Tour {
+  std::vector<int> order; // stops 1..k of the table, in visiting order
+  int length;             // home back to home, UNREACHABLE if impossible
+  bool exact;             // false if found by local search
+
+  Tour() {
+    length = UNREACHABLE;
+    exact = true;
+  }
+};
+
+// Travelling salesman over a square distance table whose row and column 0
+// are home and 1..k the stops. Distances may differ by direction.
+// Up to EXACT_TOUR_LIMIT stops, Held-Karp's dynamic program gives the
+// optimum: best[S][j] is the shortest walk from home through exactly the
+// stops in bitmask S ending at j, built from the subsets one smaller. The
+// subsets of each size are one layer, independent of each other, and are
+// shared among threads workers. Beyond the limit the 2^k table is too
+// large, and a nearest-neighbour tour is improved by 2-opt (reverse a
+// stretch) and Or-opt (move a run of up to three stops) until neither
+// move shortens it.
+class TourPlanner {
+  // Stands in for a missing leg in local search, so tours using fewer of
+  // them are preferred
+  static constexpr long MISSING = 1L << 40;
+
+  int k;
+  std::vector<long> d; // (k + 1)^2 leg lengths, MISSING for UNREACHABLE
+  std::vector<int> best;
+  std::vector<signed char> from; // stop before j in best[S][j], 0 = home
+  SearchStats work;
+
+  long leg(int a, int b) const { return d[(long)a * (k + 1) + b]; }
+
+  long length(const std::vector<int> &t) const {
+    long total = 0;
+    for (std::size_t i = 0; i + 1 < t.size(); i++) {
+      total += leg(t[i], t[i + 1]);
+    }
+    return total;
+  }
+
+  Tour heldKarp(int threads) {
+    int subsets = 1 << k;
+    best.assign((long)subsets * k, UNREACHABLE);
+    from.assign((long)subsets * k, -1);
+    for (int j = 0; j < k; j++) {
+      if (leg(0, j + 1) < MISSING) {
+        best[(long)(1 << j) * k + j] = leg(0, j + 1);
+        from[(long)(1 << j) * k + j] = 0;
+      }
+    }
+
+    // Subsets grouped by size, each group one layer of the program
+    std::vector<std::vector<int>> layers(k + 1);
+    for (int s = 1; s < subsets; s++) {
+      layers[__builtin_popcount(s)].push_back(s);
+    }
+
+    const int CHUNK = 256;
+    std::vector<SearchStats> counts(std::max(1, threads));
+    for (int size = 2; size <= k; size++) {
+      const std::vector<int> &layer = layers[size];
+      int chunks = (layer.size() + CHUNK - 1) / CHUNK;
+      parallelFor(chunks, threads, [&](int chunk, int worker) {
+        int last = std::min((int)layer.size(), (chunk + 1) * CHUNK);
+        for (int i = chunk * CHUNK; i < last; i++) {
+          int s = layer[i];
+          for (int j = 0; j < k; j++) {
+            if (!(s >> j & 1)) {
+              continue;
+            }
+            int rest = s & ~(1 << j);
+            int value = UNREACHABLE;
+            int before = -1;
+            for (int p = 0; p < k; p++) {
+              int prior = best[(long)rest * k + p];
+              if (!(rest >> p & 1) || prior == UNREACHABLE ||
+                  leg(p + 1, j + 1) >= MISSING) {
+                continue;
+              }
+              counts[worker].relaxed++;
+              long candidate = prior + leg(p + 1, j + 1);
+              if (candidate < value) {
+                value = candidate;
+                before = p + 1;
+              }
+            }
+            best[(long)s * k + j] = value;
+            from[(long)s * k + j] = before;
+            counts[worker].settled++;
+          }
+        }
+      });
+    }
+    for (const SearchStats &c : counts) {
+      work += c;
+    }
+
+    Tour tour;
+    int all = subsets - 1;
+    int end = -1;
+    long shortest = UNREACHABLE;
+    for (int j = 0; j < k; j++) {
+      int walk = best[(long)all * k + j];
+      if (walk != UNREACHABLE && leg(j + 1, 0) < MISSING &&
+          walk + leg(j + 1, 0) < shortest) {
+        shortest = walk + leg(j + 1, 0);
+        end = j;
+      }
+    }
+    if (end == -1) {
+      return tour;
+    }
+    tour.length = shortest;
+    for (int s = all, j = end; j != -1;) {
+      tour.order.push_back(j + 1);
+      int before = from[(long)s * k + j];
+      s &= ~(1 << j);
+      j = before - 1;
+    }
+    std::reverse(tour.order.begin(), tour.order.end());
+    return tour;
+  }
+
+  // Nearest unvisited stop first, from home
+  std::vector<int> nearestNeighbour() const {
+    std::vector<int> t(1, 0);
+    std::vector<bool> used(k + 1, false);
+    for (int step = 0; step < k; step++) {
+      int next = -1;
+      for (int v = 1; v <= k; v++) {
+        if (!used[v] &&
+            (next == -1 || leg(t.back(), v) < leg(t.back(), next))) {
+          next = v;
+        }
+      }
+      used[next] = true;
+      t.push_back(next);
+    }
+    t.push_back(0);
+    return t;
+  }
+
+  // Applies the first shortening 2-opt move found. Reversing t[i..j]
+  // reverses its legs too, so their lengths come from prefix sums of the
+  // tour's legs both ways.
+  bool twoOpt(std::vector<int> &t) {
+    int n = t.size();
+    std::vector<long> forward(n, 0);
+    std::vector<long> backward(n, 0);
+    for (int m = 1; m < n; m++) {
+      forward[m] = forward[m - 1] + leg(t[m - 1], t[m]);
+      backward[m] = backward[m - 1] + leg(t[m], t[m - 1]);
+    }
+    for (int i = 1; i < n - 2; i++) {
+      for (int j = i + 1; j < n - 1; j++) {
+        work.relaxed++;
+        long before = leg(t[i - 1], t[i]) + (forward[j] - forward[i]) +
+                      leg(t[j], t[j + 1]);
+        long after = leg(t[i - 1], t[j]) + (backward[j] - backward[i]) +
+                     leg(t[i], t[j + 1]);
+        if (after < before) {
+          std::reverse(t.begin() + i, t.begin() + j + 1);
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  // Applies the first shortening move of a run of 1-3 stops elsewhere
+  bool orOpt(std::vector<int> &t) {
+    int n = t.size();
+    for (int run = 1; run <= 3; run++) {
+      for (int i = 1; i + run < n; i++) {
+        int first = t[i];
+        int last = t[i + run - 1];
+        long cut = leg(t[i - 1], first) + leg(last, t[i + run]) -
+                   leg(t[i - 1], t[i + run]);
+        for (int p = 0; p + 1 < n; p++) {
+          if (p >= i - 1 && p < i + run) {
+            continue;
+          }
+          work.relaxed++;
+          long paste =
+              leg(t[p], first) + leg(last, t[p + 1]) - leg(t[p], t[p + 1]);
+          if (paste < cut) {
+            std::vector<int> moved(t.begin() + i, t.begin() + i + run);
+            t.erase(t.begin() + i, t.begin() + i + run);
+            int at = p < i ? p + 1 : p + 1 - run;
+            t.insert(t.begin() + at, moved.begin(), moved.end());
+            return true;
+          }
+        }
+      }
+    }
+    return false;
+  }
+
+  Tour localSearch() {
+    std::vector<int> t = nearestNeighbour();
+    while (twoOpt(t) || orOpt(t)) {
+      work.settled++;
+    }
+
+    Tour tour;
+    tour.exact = false;
+    long total = length(t);
+    if (total < MISSING) {
+      tour.length = total;
+      tour.order.assign(t.begin() + 1, t.end() - 1);
+    }
+    return tour;
+  }
+
+public:
+  TourPlanner() { k = 0; }
+
+  // Best (or, beyond EXACT_TOUR_LIMIT stops, a good) order of the stops of
+  // table, whose entry 0 is home
+  Tour solve(const DistanceTable &table, int threads = 1) {
+    k = table.rows - 1;
+    work.clear();
+    if (k <= 0) {
+      Tour tour;
+      tour.length = 0;
+      return tour;
+    }
+
+    d.resize((long)(k + 1) * (k + 1));
+    for (int a = 0; a <= k; a++) {
+      for (int b = 0; b <= k; b++) {
+        int v = table.at(a, b);
+        d[(long)a * (k + 1) + b] = v == UNREACHABLE ? MISSING : v;
+      }
+    }
+
+    Tour tour;
+    if (k <= EXACT_TOUR_LIMIT) {
+      tour = heldKarp(threads);
+      work.bytes = best.capacity() * sizeof(int) + from.capacity();
+    } else {
+      tour = localSearch();
+      work.bytes = d.capacity() * sizeof(long);
+    }
+    return tour;
+  }
+
+  // Counters of the last solve: settled counts dynamic program entries or
+  // local search moves, relaxed the transitions or moves tried
+  const SearchStats &stats() const { return work; }
+};
+
+#endif
@@ -42,9 +42,11 @@ void setupFindRouteCallback(Button *findBtn, Dropdown *fromDd, Dropdown *toDd,
       break;
     }
 
-    // Search for ALL optimal paths
+    // Search for ALL optimal paths, from the precomputed tables while they
+    // still match the graph, or from the cache of recent answers
+    SearchStats stats;
     std::vector<std::shared_ptr<Waypoint>> results =
-        g.searchAll(start, end, criteria);
+        g.findRoutes(start, end, criteria, &allPairs, &stats);
     currentPaths = results; // Store for drawing
     mapCanvas->redraw();    // Trigger redraw
 
@@ -91,6 +93,12 @@ void setupFindRouteCallback(Button *findBtn, Dropdown *fromDd, Dropdown *toDd,
         ss << "Total Stops: " << result->stops << "\n\n";
       }
 
+      ss << "--- Search Statistics ---\n";
+      ss << stats.summary();
+      ss << "Route cache: " << g.routeCache().hits() << " hits, "
+         << g.routeCache().misses() << " misses, "
+         << g.routeCache().evictions() << " evictions\n";
+
       resultOutput->value(ss.str());
     } else {
       resultOutput->value("No route found between selected airports.");
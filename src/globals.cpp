@@ -8,6 +8,7 @@
 Graph g;
 ArrayList<Vertex *> airports;
 std::vector<std::shared_ptr<Waypoint>> currentPaths;
+AllPairsTable allPairs;
 
 // UI components
 Dropdown *fromDd = nullptr;
@@ -22,6 +23,16 @@ void loadData() {
 
   // Load data directly from files
   FileLoader::loadIntoGraph(g, airports);
+
+  // Group the airports by reachability now, so a query with no possible
+  // route is answered without searching; added routes keep it current
+  g.reachability();
+
+  // Precompute every route of small networks so Find Route is a lookup
+  allPairs = AllPairsTable();
+  if (airports.size() < ALL_PAIRS_LIMIT) {
+    allPairs = AllPairsTable(g.freeze());
+  }
 }
 
 void refreshDropdowns() {
@@ -18,6 +18,10 @@ class MapWidget;
 extern Graph g;
 extern ArrayList<Vertex *> airports;
 extern std::vector<std::shared_ptr<Waypoint>> currentPaths;
+extern AllPairsTable allPairs;
+
+// Networks below this many airports get all-pairs tables at load time
+const int ALL_PAIRS_LIMIT = 5000;
 
 // UI components that need global access
 extern Dropdown *fromDd;
@@ -0,0 +1,56 @@
+#ifndef TEST_FIXTURES_H
+#define TEST_FIXTURES_H
+
+#include <CompactGraph.h>
+#include <Dijkstra.h>
+#include <cstdlib>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// Shared fixtures of the specs that check an algorithm against Dijkstra
+// on a random network rather than a hand-built one
+
+// n vertices at random points of a 1000 x 1000 map, each with degree arcs
+// to random vertices costing 1..maxCost and taking 1..maxDuration, with
+// the reverse index and bounds built. Seeds rand() with seed, so specs
+// that draw more numbers afterwards are repeatable too.
+inline CompactGraph randomCompactGraph(unsigned seed, int n, int degree,
+                                       int maxCost = 500,
+                                       int maxDuration = 600) {
+  srand(seed);
+  CompactGraph g;
+  for (int u = 0; u < n; u++) {
+    g.addVertex(rand() % 1000, rand() % 1000);
+    for (int i = 0; i < degree; i++) {
+      g.addArc(rand() % n, 1 + rand() % maxCost, 1 + rand() % maxDuration);
+    }
+  }
+  g.buildReverse();
+  g.computeBounds();
+  return g;
+}
+
+// Asserts that tree, anything with distance(v), parentOf(v) and arcTo(v),
+// holds the shortest distances from source under criteria that Dijkstra
+// finds, limited to those at most bound, and that its arcs are tight
+template <class Tree>
+void checkTreeAgainstDijkstra(const CompactGraph &g, const Tree &tree,
+                              int source, SearchCriteria criteria,
+                              int bound = UNREACHABLE) {
+  Dijkstra engine;
+  engine.run(g, source, -1, criteria);
+  for (int v = 0; v < g.vertexCount(); v++) {
+    int d = engine.distance(v);
+    Assert::That(tree.distance(v), Equals(d <= bound ? d : UNREACHABLE));
+    if (v != source && tree.distance(v) != UNREACHABLE) {
+      int arc = tree.arcTo(v);
+      Assert::That(g.targets[arc], Equals(v));
+      Assert::That(g.tail(arc), Equals(tree.parentOf(v)));
+      Assert::That(tree.distance(tree.parentOf(v)) + g.weight(arc, criteria),
+                   Equals(d));
+    }
+  }
+}
+
+#endif
@@ -3,12 +3,42 @@
 // Air Route Planner - Unit Tests
 // =============================================================================
 
+#include "test_allpairstable.h"
 #include "test_arraylist.h"
+#include "test_astar.h"
+#include "test_bidirectional.h"
+#include "test_bitset.h"
+#include "test_bucketqueue.h"
+#include "test_compactgraph.h"
+#include "test_connectionscan.h"
+#include "test_constrainedsearch.h"
+#include "test_contractionhierarchy.h"
+#include "test_deltastepping.h"
+#include "test_dijkstra.h"
+#include "test_directionoptimizingbfs.h"
+#include "test_distancetable.h"
+#include "test_dynamictree.h"
 #include "test_graph.h"
 #include "test_hashtable.h"
+#include "test_indexedheap.h"
+#include "test_kshortest.h"
+#include "test_labelarena.h"
+#include "test_landmarks.h"
 #include "test_linkedlist.h"
+#include "test_lrucache.h"
+#include "test_optimalpaths.h"
+#include "test_parallel.h"
+#include "test_paretosearch.h"
 #include "test_queue.h"
+#include "test_raptor.h"
+#include "test_reachability.h"
+#include "test_routetimetable.h"
+#include "test_searchstats.h"
+#include "test_searchtrace.h"
+#include "test_shortestpathtree.h"
 #include "test_stack.h"
+#include "test_timetable.h"
+#include "test_tourplanner.h"
 
 int main(int argc, const char *argv[]) {
   return TestRunner::RunAllTests(argc, const_cast<char **>(argv));
@@ -0,0 +1,144 @@
+#ifndef TEST_ALL_PAIRS_TABLE_H
+#define TEST_ALL_PAIRS_TABLE_H
+
+#include "fixtures.h"
+#include <AllPairsTable.h>
+#include <Graph.h>
+#include <igloo/igloo.h>
+#include <set>
+
+using namespace igloo;
+
+// =============================================================================
+// All Pairs Table Tests
+// Tests for the precomputed distance and next-hop matrices
+// =============================================================================
+Context(AllPairsTableTests) {
+  CompactGraph random;
+
+  // Few distinct fares, so many routes tie
+  void SetUp() { random = randomCompactGraph(21, 60, 3, 9, 90); }
+
+  // Airports of a route in travel order
+  std::vector<Vertex *> airports(std::shared_ptr<Waypoint> wp) {
+    std::vector<Vertex *> stops;
+    for (; wp != nullptr; wp = wp->parent) {
+      stops.insert(stops.begin(), wp->vertex);
+    }
+    return stops;
+  }
+
+  Spec(MatchesDijkstraForEveryPair) {
+    AllPairsTable table(random, {CHEAPEST, FASTEST}, 3);
+    Assert::That(table.has(CHEAPEST), IsTrue());
+    Assert::That(table.has(LEAST_STOPS), IsFalse());
+
+    Dijkstra engine;
+    for (int s = 0; s < 60; s++) {
+      engine.run(random, s, -1, FASTEST);
+      for (int t = 0; t < 60; t++) {
+        Assert::That(table.distance(s, t, FASTEST),
+                     Equals(engine.distance(t)));
+      }
+    }
+  }
+
+  Spec(NextHopsFollowShortestPaths) {
+    AllPairsTable table(random);
+    for (int s = 0; s < 60; s++) {
+      for (int t = 0; t < 60; t++) {
+        std::vector<int> arcs = table.pathArcs(random, s, t, CHEAPEST);
+        int d = table.distance(s, t, CHEAPEST);
+        if (d == UNREACHABLE || s == t) {
+          Assert::That(arcs.empty(), IsTrue());
+          continue;
+        }
+        int total = 0;
+        int u = s;
+        for (int arc : arcs) {
+          Assert::That(arc >= random.begin(u) && arc < random.end(u),
+                       IsTrue());
+          total += random.costs[arc];
+          u = random.targets[arc];
+        }
+        Assert::That(u, Equals(t));
+        Assert::That(total, Equals(d));
+      }
+    }
+  }
+
+  Spec(ListsAllTiesOnGrid) {
+    // 3x3 grid going right and down, every leg $1: C(4, 2) tied paths
+    Graph g;
+    Vertex *grid[3][3];
+    for (int r = 0; r < 3; r++) {
+      for (int c = 0; c < 3; c++) {
+        grid[r][c] = new Vertex(std::string(1, 'A' + r * 3 + c));
+        g.addVertex(grid[r][c]);
+      }
+    }
+    for (int r = 0; r < 3; r++) {
+      for (int c = 0; c < 3; c++) {
+        if (c + 1 < 3) {
+          g.addDirectedEdge(grid[r][c], grid[r][c + 1], 1, 1);
+        }
+        if (r + 1 < 3) {
+          g.addDirectedEdge(grid[r][c], grid[r + 1][c], 1, 1);
+        }
+      }
+    }
+
+    AllPairsTable table(g.freeze());
+    std::vector<std::shared_ptr<Waypoint>> paths =
+        g.searchAll(grid[0][0], grid[2][2], CHEAPEST, table);
+    Assert::That(paths.size(), Equals(6u));
+    for (const auto &p : paths) {
+      Assert::That(p->totalCost, Equals(4));
+    }
+    Assert::That(g.searchAll(grid[0][0], grid[2][2], CHEAPEST, table, 2)
+                     .size(),
+                 Equals(2u));
+
+    g.addDirectedEdge(grid[0][0], grid[2][2], 1, 1);
+    AssertThrows(std::logic_error,
+                 g.searchAll(grid[0][0], grid[2][2], CHEAPEST, table));
+  }
+
+  Spec(ListsTheSameTiesAsTheSearch) {
+    // Zero-duration legs both ways tie the middle airports in a cycle
+    Graph g;
+    Vertex *v[5];
+    for (int i = 0; i < 5; i++) {
+      v[i] = new Vertex(std::string(1, 'A' + i));
+      g.addVertex(v[i]);
+    }
+    g.addEdge(v[0], v[1], 5);
+    g.addEdge(v[1], v[2], 5);
+    g.addEdge(v[0], v[3], 5);
+    g.addEdge(v[3], v[2], 5);
+    g.addEdge(v[1], v[3], 5);
+    g.addEdge(v[2], v[4], 5);
+    g.addDirectedEdge(v[4], v[0], 0, 0);
+
+    AllPairsTable table(g.freeze());
+    for (int s = 0; s < 5; s++) {
+      for (int t = 0; t < 5; t++) {
+        for (SearchCriteria c : {CHEAPEST, FASTEST}) {
+          std::set<std::vector<Vertex *>> online;
+          for (const auto &p : g.searchAll(v[s], v[t], c)) {
+            online.insert(airports(p));
+          }
+          std::set<std::vector<Vertex *>> tabled;
+          for (const auto &p : g.searchAll(v[s], v[t], c, table)) {
+            tabled.insert(airports(p));
+          }
+          Assert::That(tabled == online, IsTrue());
+        }
+      }
+    }
+    Assert::That((int)g.searchAll(v[0], v[4], FASTEST, table).size(),
+                 Equals(4));
+  }
+};
+
+#endif
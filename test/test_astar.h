@@ -0,0 +1,111 @@
+#ifndef TEST_A_STAR_H
+#define TEST_A_STAR_H
+
+#include <Graph.h>
+#include <igloo/igloo.h>
+#include <random>
+
+using namespace igloo;
+
+// =============================================================================
+// A* Tests
+// Tests for coordinate-guided search against plain Dijkstra
+// =============================================================================
+Context(AStarTests) {
+  Graph g;
+  Vertex *grid[5][5];
+
+  void SetUp() {
+    // 5x5 grid, 100 map units apart, fares proportional to distance
+    g = Graph();
+    for (int r = 0; r < 5; r++) {
+      for (int c = 0; c < 5; c++) {
+        grid[r][c] = new Vertex(std::string(1, 'A' + r * 5 + c), c * 100,
+                                r * 100);
+        g.addVertex(grid[r][c]);
+      }
+    }
+    for (int r = 0; r < 5; r++) {
+      for (int c = 0; c < 5; c++) {
+        if (c + 1 < 5) {
+          g.addEdge(grid[r][c], grid[r][c + 1], 100, 60);
+        }
+        if (r + 1 < 5) {
+          g.addEdge(grid[r][c], grid[r + 1][c], 100, 60);
+        }
+      }
+    }
+  }
+
+  Spec(RatiosComeFromCheapestArc) {
+    const CompactGraph &compact = g.freeze();
+    Assert::That(compact.perUnit(CHEAPEST), EqualsWithDelta(1.0, 1e-9));
+    Assert::That(compact.perUnit(FASTEST), EqualsWithDelta(0.6, 1e-9));
+    Assert::That(compact.perUnit(LEAST_STOPS), EqualsWithDelta(0.01, 1e-9));
+  }
+
+  Spec(PotentialNeverOverestimates) {
+    const CompactGraph &compact = g.freeze();
+    GeometricPotential h(compact, grid[4][4]->id, CHEAPEST);
+    Assert::That(h(grid[0][0]->id) <= 800, IsTrue());
+    Assert::That(h(grid[4][4]->id), Equals(0));
+  }
+
+  Spec(MatchesDijkstraCost) {
+    std::shared_ptr<Waypoint> expected =
+        g.search(grid[0][0], grid[3][4], FASTEST);
+    std::shared_ptr<Waypoint> result = g.astar(grid[0][0], grid[3][4], FASTEST);
+    Assert::That(result != nullptr);
+    Assert::That(result->vertex->data, Equals(grid[3][4]->data));
+    Assert::That(result->totalTime, Equals(expected->totalTime));
+    Assert::That(result->stops, Equals(7));
+  }
+
+  Spec(SettlesFewerAirports) {
+    g.search(grid[2][0], grid[2][4], CHEAPEST);
+    int dijkstra = g.lastSettledCount();
+    g.astar(grid[2][0], grid[2][4], CHEAPEST);
+    int astar = g.lastSettledCount();
+    Assert::That(astar < dijkstra, IsTrue());
+  }
+
+  Spec(NoPath) {
+    Vertex *isolated = new Vertex("Isolated", 900, 900);
+    g.addVertex(isolated);
+    Assert::That(g.astar(grid[0][0], isolated, CHEAPEST) == nullptr);
+  }
+
+  Spec(OptimalOnRandomNetwork) {
+    Graph r;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> coord(0, 600);
+    std::uniform_int_distribution<int> pick(0, 29);
+    std::uniform_int_distribution<int> markup(0, 300);
+
+    std::vector<Vertex *> vs;
+    for (int i = 0; i < 30; i++) {
+      vs.push_back(new Vertex("V" + std::to_string(i), coord(rng), coord(rng)));
+      r.addVertex(vs.back());
+    }
+    for (int i = 0; i < 90; i++) {
+      Vertex *a = vs[pick(rng)];
+      Vertex *b = vs[pick(rng)];
+      int length = (int)std::hypot(a->x - b->x, a->y - b->y);
+      r.addDirectedEdge(a, b, length + markup(rng), length / 2 + markup(rng));
+    }
+
+    SearchCriteria modes[] = {CHEAPEST, FASTEST, LEAST_STOPS};
+    for (SearchCriteria mode : modes) {
+      for (int t = 1; t < 30; t += 4) {
+        std::shared_ptr<Waypoint> expected = r.search(vs[0], vs[t], mode);
+        std::shared_ptr<Waypoint> result = r.astar(vs[0], vs[t], mode);
+        Assert::That(result == nullptr, Equals(expected == nullptr));
+        if (expected) {
+          Assert::That(result->partialCost, Equals(expected->partialCost));
+        }
+      }
+    }
+  }
+};
+
+#endif // TEST_A_STAR_H
@@ -0,0 +1,100 @@
+#ifndef TEST_BIDIRECTIONAL_H
+#define TEST_BIDIRECTIONAL_H
+
+#include <Graph.h>
+#include <igloo/igloo.h>
+#include <random>
+
+using namespace igloo;
+
+// =============================================================================
+// Bidirectional Search Tests
+// Tests for meeting-in-the-middle Dijkstra against the forward search
+// =============================================================================
+Context(BidirectionalTests) {
+  Graph g;
+  std::vector<Vertex *> line;
+
+  void SetUp() {
+    // 41 airports on a line, each hop $10 and 30 minutes
+    g = Graph();
+    line.clear();
+    for (int i = 0; i <= 40; i++) {
+      line.push_back(new Vertex("L" + std::to_string(i), i * 10, 0));
+      g.addVertex(line.back());
+      if (i > 0) {
+        g.addEdge(line[i - 1], line[i], 10, 30);
+      }
+    }
+  }
+
+  Spec(FindsPathAcrossLine) {
+    std::shared_ptr<Waypoint> result =
+        g.searchBidirectional(line[20], line[0], CHEAPEST);
+    Assert::That(result != nullptr);
+    Assert::That(result->vertex->data, Equals("L0"));
+    Assert::That(result->totalCost, Equals(200));
+    Assert::That(result->totalTime, Equals(600));
+    Assert::That(result->stops, Equals(20));
+    Assert::That(result->parent->vertex->data, Equals("L1"));
+  }
+
+  Spec(SettlesFewerThanForwardSearch) {
+    g.search(line[20], line[0], FASTEST);
+    int forward = g.lastSettledCount();
+    g.searchBidirectional(line[20], line[0], FASTEST);
+    Assert::That(g.lastSettledCount() < forward, IsTrue());
+  }
+
+  Spec(SameStartEnd) {
+    std::shared_ptr<Waypoint> result =
+        g.searchBidirectional(line[3], line[3], CHEAPEST);
+    Assert::That(result != nullptr);
+    Assert::That(result->parent == nullptr);
+  }
+
+  Spec(OneWayEdgesRespected) {
+    Vertex *a = new Vertex("OneWayA");
+    Vertex *b = new Vertex("OneWayB");
+    g.addVertex(a);
+    g.addVertex(b);
+    g.addDirectedEdge(a, b, 5, 5);
+    Assert::That(g.searchBidirectional(a, b, CHEAPEST) != nullptr);
+    Assert::That(g.searchBidirectional(b, a, CHEAPEST) == nullptr);
+  }
+
+  Spec(MatchesForwardSearchOnRandomNetwork) {
+    Graph r;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> pick(0, 39);
+    std::uniform_int_distribution<int> fare(50, 900);
+    std::uniform_int_distribution<int> minutes(40, 600);
+
+    std::vector<Vertex *> vs;
+    for (int i = 0; i < 40; i++) {
+      vs.push_back(new Vertex("V" + std::to_string(i)));
+      r.addVertex(vs.back());
+    }
+    for (int i = 0; i < 120; i++) {
+      r.addDirectedEdge(vs[pick(rng)], vs[pick(rng)], fare(rng), minutes(rng));
+    }
+
+    SearchCriteria modes[] = {CHEAPEST, FASTEST, LEAST_STOPS};
+    for (SearchCriteria mode : modes) {
+      for (int s = 0; s < 40; s += 7) {
+        for (int t = 1; t < 40; t += 5) {
+          std::shared_ptr<Waypoint> expected = r.search(vs[s], vs[t], mode);
+          std::shared_ptr<Waypoint> result =
+              r.searchBidirectional(vs[s], vs[t], mode);
+          Assert::That(result == nullptr, Equals(expected == nullptr));
+          if (expected) {
+            Assert::That(result->partialCost, Equals(expected->partialCost));
+            Assert::That(result->vertex == vs[t], IsTrue());
+          }
+        }
+      }
+    }
+  }
+};
+
+#endif // TEST_BIDIRECTIONAL_H
@@ -0,0 +1,62 @@
+#ifndef TEST_BITSET_H
+#define TEST_BITSET_H
+
+#include <Bitset.h>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// Bitset Tests
+// Tests for the packed set of dense ids
+// =============================================================================
+Context(BitsetTests) {
+  Spec(StartsEmpty) {
+    Bitset bits(100);
+    Assert::That(bits.size(), Equals(100));
+    Assert::That(bits.wordCount(), Equals(2));
+    Assert::That(bits.count(), Equals(0));
+    Assert::That(bits.test(99), IsFalse());
+  }
+
+  Spec(SetsAndResetsAcrossWords) {
+    Bitset bits(130);
+    bits.set(0);
+    bits.set(63);
+    bits.set(64);
+    bits.set(129);
+    Assert::That(bits.count(), Equals(4));
+    Assert::That(bits.test(63), IsTrue());
+    Assert::That(bits.test(62), IsFalse());
+    Assert::That(bits.word(1), Equals(1ull));
+
+    bits.reset(63);
+    Assert::That(bits.test(63), IsFalse());
+    Assert::That(bits.count(), Equals(3));
+  }
+
+  Spec(ClearAndResizeEmptyTheSet) {
+    Bitset bits(10);
+    bits.set(3);
+    bits.clear();
+    Assert::That(bits.test(3), IsFalse());
+
+    bits.set(5);
+    bits.resize(200);
+    Assert::That(bits.size(), Equals(200));
+    Assert::That(bits.count(), Equals(0));
+  }
+
+  Spec(SwapExchangesContents) {
+    Bitset a(10);
+    Bitset b(70);
+    a.set(1);
+    b.set(69);
+    a.swap(b);
+    Assert::That(a.size(), Equals(70));
+    Assert::That(a.test(69), IsTrue());
+    Assert::That(b.test(1), IsTrue());
+  }
+};
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef TEST_BUCKET_QUEUE_H
+#define TEST_BUCKET_QUEUE_H
+
+#include "fixtures.h"
+#include <BucketQueue.h>
+#include <Dijkstra.h>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// Zero A* estimate, which keeps Dijkstra on its comparison heap
+struct ZeroPotential {
+  int operator()(int v) const { return 0; }
+};
+
+// =============================================================================
+// Bucket Queue Tests
+// Tests for Dial's monotone bucket queue and Dijkstra's use of it
+// =============================================================================
+Context(BucketQueueTests) {
+  BucketQueue q;
+
+  void SetUp() { q = BucketQueue(8, 10); }
+
+  Spec(InitiallyEmpty) {
+    Assert::That(q.isEmpty(), IsTrue());
+    Assert::That(q.capacity(), Equals(8));
+    Assert::That(q.spread(), Equals(10));
+  }
+
+  Spec(PopsInKeyOrder) {
+    q.push(1, 3);
+    q.push(0, 7);
+    q.push(2, 10);
+    q.push(3, 5);
+    Assert::That(q.pop(), Equals(1));
+    Assert::That(q.pop(), Equals(3));
+    Assert::That(q.pop(), Equals(0));
+    Assert::That(q.pop(), Equals(2));
+    Assert::That(q.isEmpty(), IsTrue());
+  }
+
+  Spec(WrapsAroundTheRing) {
+    // Keys grow past the ring size as in a Dijkstra run
+    q.push(0, 0);
+    int last = 0;
+    for (int id = 1; id < 8; id++) {
+      last = q.topKey();
+      q.pop();
+      q.push(id, last + 9);
+    }
+    Assert::That(q.topKey(), Equals(last + 9));
+    Assert::That(q.pop(), Equals(7));
+  }
+
+  Spec(DecreaseKeyMovesToFront) {
+    q.push(0, 2);
+    q.push(1, 9);
+    q.push(2, 7);
+    q.pop();
+    q.decreaseKey(1, 4);
+    Assert::That(q.top(), Equals(1));
+    Assert::That(q.pushOrDecrease(1, 5), IsFalse());
+    Assert::That(q.key(1), Equals(4));
+  }
+
+  Spec(RejectsKeysOutsideWindow) {
+    q.push(0, 20);
+    AssertThrows(std::logic_error, q.push(1, 31));
+    q.pop();
+    AssertThrows(std::logic_error, q.push(1, 19));
+  }
+
+  Spec(ClearAcceptsAnyFirstKey) {
+    q.push(0, 50);
+    q.push(1, 55);
+    q.clear();
+    Assert::That(q.isEmpty(), IsTrue());
+    Assert::That(q.contains(0), IsFalse());
+    q.push(1, 3);
+    Assert::That(q.pop(), Equals(1));
+  }
+
+  Spec(DijkstraMatchesHeapOnSmallWeights) {
+    // Fares fit the bucket queue, durations do not
+    CompactGraph g = randomCompactGraph(16, 500, 4, 30, 2000);
+
+    Dijkstra buckets;
+    Dijkstra heap;
+    SilentTrace trace;
+    for (SearchCriteria mode : {CHEAPEST, LEAST_STOPS}) {
+      buckets.run(g, 3, -1, mode);
+      heap.run(g, 3, -1, mode, trace, ZeroPotential());
+      Assert::That(buckets.usedBucketQueue(), IsTrue());
+      Assert::That(heap.usedBucketQueue(), IsFalse());
+      for (int v = 0; v < 500; v++) {
+        Assert::That(buckets.distance(v), Equals(heap.distance(v)));
+      }
+    }
+
+    // Durations exceed the limit, so the heap is used
+    buckets.run(g, 3, -1, FASTEST);
+    Assert::That(buckets.usedBucketQueue(), IsFalse());
+  }
+};
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef TEST_COMPACT_GRAPH_H
+#define TEST_COMPACT_GRAPH_H
+
+#include <Graph.h>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// Compact Graph Tests
+// Tests for the CSR snapshot produced by Graph::freeze
+// =============================================================================
+Context(CompactGraphTests) {
+  Graph g;
+  Vertex *a;
+  Vertex *b;
+  Vertex *c;
+
+  void SetUp() {
+    g = Graph();
+    a = new Vertex("A");
+    b = new Vertex("B");
+    c = new Vertex("C");
+
+    g.addVertex(a);
+    g.addVertex(b);
+    g.addVertex(c);
+
+    g.addDirectedEdge(a, b, 10, 20);
+    g.addDirectedEdge(a, c, 30, 40);
+    g.addDirectedEdge(c, b, 5, 6);
+  }
+
+  Spec(VerticesGetDenseIds) {
+    Assert::That(a->id, Equals(0));
+    Assert::That(b->id, Equals(1));
+    Assert::That(c->id, Equals(2));
+  }
+
+  Spec(OffsetsDelimitEachVertexsArcs) {
+    const CompactGraph &compact = g.freeze();
+    Assert::That(compact.vertexCount(), Equals(3));
+    Assert::That(compact.arcCount(), Equals(3));
+    Assert::That(compact.degree(0), Equals(2));
+    Assert::That(compact.degree(1), Equals(0));
+    Assert::That(compact.degree(2), Equals(1));
+  }
+
+  Spec(ArcsKeepEdgeListOrder) {
+    const CompactGraph &compact = g.freeze();
+    Assert::That(compact.targets[compact.begin(0)], Equals(1));
+    Assert::That(compact.targets[compact.begin(0) + 1], Equals(2));
+    Assert::That(compact.costs[compact.begin(2)], Equals(5));
+    Assert::That(compact.durations[compact.begin(2)], Equals(6));
+  }
+
+  Spec(WeightFollowsCriteria) {
+    const CompactGraph &compact = g.freeze();
+    int arc = compact.begin(0);
+    Assert::That(compact.weight(arc, CHEAPEST), Equals(10));
+    Assert::That(compact.weight(arc, FASTEST), Equals(20));
+    Assert::That(compact.weight(arc, LEAST_STOPS), Equals(1));
+  }
+
+  Spec(TwelveBytesPerArcPlusReverseIndex) {
+    const CompactGraph &compact = g.freeze();
+    // Both offset arrays and the x/y coordinates are the per-vertex arrays
+    int perVertex = (4 * compact.vertexCount() + 2) * sizeof(int);
+    // 12 bytes forward (target, cost, duration), 8 reverse (source, arc)
+    Assert::That((int)compact.bytes() - perVertex,
+                 Equals(compact.arcCount() * 20));
+  }
+
+  Spec(ReverseIndexListsIncomingArcs) {
+    const CompactGraph &compact = g.freeze();
+    // B is entered from A and from C
+    Assert::That(compact.inEnd(1) - compact.inBegin(1), Equals(2));
+    Assert::That(compact.sources[compact.inBegin(1)], Equals(0));
+    Assert::That(compact.sources[compact.inBegin(1) + 1], Equals(2));
+    int arc = compact.inArcs[compact.inBegin(1) + 1];
+    Assert::That(compact.targets[arc], Equals(1));
+    Assert::That(compact.costs[arc], Equals(5));
+    Assert::That(compact.inEnd(0) - compact.inBegin(0), Equals(0));
+  }
+
+  Spec(SnapshotIsReusedUntilGraphChanges) {
+    const CompactGraph &first = g.freeze();
+    long version = first.version;
+    Assert::That(g.freeze().version, Equals(version));
+
+    g.addDirectedEdge(b, a, 1, 1);
+    const CompactGraph &second = g.freeze();
+    Assert::That(second.version == version, IsFalse());
+    Assert::That(second.arcCount(), Equals(4));
+  }
+
+  Spec(ArcEdgeMapsBackToEdgeList) {
+    g.freeze();
+    Assert::That(g.arcEdge(0, 1) == a->edgeList[1], IsTrue());
+  }
+
+  Spec(PathFromArcsAccumulatesTotals) {
+    const CompactGraph &compact = g.freeze();
+    std::vector<int> arcs;
+    arcs.push_back(compact.begin(0) + 1);
+    arcs.push_back(compact.begin(2));
+
+    std::shared_ptr<Waypoint> result = g.pathFromArcs(0, arcs, FASTEST);
+    Assert::That(result->vertex->data, Equals("B"));
+    Assert::That(result->totalCost, Equals(35));
+    Assert::That(result->totalTime, Equals(46));
+    Assert::That(result->partialCost, Equals(46));
+    Assert::That(result->parent->vertex->data, Equals("C"));
+  }
+};
+
+#endif // TEST_COMPACT_GRAPH_H
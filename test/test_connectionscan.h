@@ -0,0 +1,137 @@
+#ifndef TEST_CONNECTION_SCAN_H
+#define TEST_CONNECTION_SCAN_H
+
+#include <ConnectionScan.h>
+#include <Graph.h>
+#include <cstdlib>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// Connection Scan Tests
+// Tests for earliest-arrival queries on timetables
+// =============================================================================
+Context(ConnectionScanTests) {
+  // 0 -> 1 -> 2 on one through flight, and a separate 1 -> 2 flight that
+  // leaves too soon after landing at 1 to make the layover
+  Timetable sample() {
+    Timetable tt(4, 45);
+    int through = tt.newTrip();
+    tt.addConnection(0, 1, Timetable::parseTime("08:10"),
+                     Timetable::parseTime("09:00"), 120, through);
+    tt.addConnection(1, 2, Timetable::parseTime("09:20"),
+                     Timetable::parseTime("11:45"), 200, through);
+    tt.addConnection(1, 2, Timetable::parseTime("09:30"),
+                     Timetable::parseTime("11:00"), 150);
+    tt.addConnection(1, 3, Timetable::parseTime("10:00"),
+                     Timetable::parseTime("10:30"), 80);
+    tt.sort();
+    return tt;
+  }
+
+  Spec(StaysAboardThroughFlights) {
+    Timetable tt = sample();
+    ConnectionScan csa;
+    csa.run(tt, 0, Timetable::parseTime("08:00"));
+    Assert::That(csa.arrivalTime(2), Equals(Timetable::parseTime("11:45")));
+    Assert::That(csa.arrivalTime(3), Equals(Timetable::parseTime("10:30")));
+    Assert::That(csa.journey(tt, 2).size(), Equals(2u));
+  }
+
+  Spec(HonoursTheLayover) {
+    Timetable tt = sample();
+    tt.setLayover(1, 30);
+    ConnectionScan csa;
+    csa.run(tt, 0, Timetable::parseTime("08:00"), 2);
+    Assert::That(csa.arrivalTime(2), Equals(Timetable::parseTime("11:00")));
+
+    std::vector<int> legs = csa.journey(tt, 2);
+    Assert::That(legs.size(), Equals(2u));
+    Assert::That(tt[legs[0]].to, Equals(1));
+    Assert::That(tt[legs[1]].trip != tt[legs[0]].trip, IsTrue());
+  }
+
+  Spec(MissesFlightsThatAlreadyLeft) {
+    Timetable tt = sample();
+    ConnectionScan csa;
+    csa.run(tt, 0, Timetable::parseTime("08:11"));
+    Assert::That(csa.arrivalTime(2), Equals(UNREACHABLE));
+    Assert::That(csa.journey(tt, 2).empty(), IsTrue());
+  }
+
+  Spec(RequiresASortedTimetable) {
+    Timetable tt = sample();
+    tt.addConnection(2, 0, 900, 1000);
+    ConnectionScan csa;
+    AssertThrows(std::logic_error, csa.run(tt, 0, 0));
+  }
+
+  Spec(MatchesRepeatedRelaxation) {
+    srand(18);
+    int n = 200;
+    Timetable tt(n, 20);
+    for (int i = 0; i < 20000; i++) {
+      int departure = rand() % (24 * 60);
+      tt.addConnection(rand() % n, rand() % n, departure,
+                       departure + 30 + rand() % 300);
+    }
+    tt.sort();
+
+    ConnectionScan csa;
+    csa.run(tt, 9, 360);
+
+    // Relax every connection until nothing improves
+    std::vector<int> best(n, UNREACHABLE);
+    best[9] = 360;
+    for (bool changed = true; changed;) {
+      changed = false;
+      for (int i = 0; i < tt.connectionCount(); i++) {
+        const Connection &c = tt[i];
+        if (best[c.from] == UNREACHABLE) {
+          continue;
+        }
+        int ready = best[c.from] + (c.from == 9 ? 0 : tt.layover(c.from));
+        if (ready <= c.departure && c.arrival < best[c.to]) {
+          best[c.to] = c.arrival;
+          changed = true;
+        }
+      }
+    }
+
+    for (int v = 0; v < n; v++) {
+      Assert::That(csa.arrivalTime(v), Equals(best[v]));
+      if (v != 9 && best[v] != UNREACHABLE) {
+        std::vector<int> legs = csa.journey(tt, v);
+        Assert::That(tt[legs.front()].from, Equals(9));
+        Assert::That(tt[legs.back()].arrival, Equals(best[v]));
+      }
+    }
+  }
+
+  Spec(GraphAnswersFromTheTimetable) {
+    Graph g;
+    Vertex *sfo = new Vertex("SFO");
+    Vertex *ord = new Vertex("ORD");
+    Vertex *nyc = new Vertex("NYC");
+    g.addVertex(sfo);
+    g.addVertex(ord);
+    g.addVertex(nyc);
+
+    Timetable tt(3, 40);
+    tt.addConnection(sfo->id, ord->id, 480, 720, 180);
+    tt.addConnection(ord->id, nyc->id, 780, 900, 140);
+    tt.sort();
+
+    SearchStats stats;
+    std::vector<int> legs = g.earliestArrival(sfo, nyc, 420, tt, &stats);
+    Assert::That(legs.size(), Equals(2u));
+    Assert::That(tt[legs[1]].arrival, Equals(900));
+    Assert::That(stats.relaxed, Equals(2));
+
+    AssertThrows(std::logic_error,
+                 g.earliestArrival(sfo, nyc, 420, Timetable(2)));
+  }
+};
+
+#endif
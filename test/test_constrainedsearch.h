@@ -0,0 +1,120 @@
+#ifndef TEST_CONSTRAINED_SEARCH_H
+#define TEST_CONSTRAINED_SEARCH_H
+
+#include "fixtures.h"
+#include <ConstrainedSearch.h>
+#include <Graph.h>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// Constrained Search Tests
+// Tests for best itineraries under a budget on a second criteria
+// =============================================================================
+Context(ConstrainedSearchTests) {
+  Graph g;
+  Vertex *sfo;
+  Vertex *den;
+  Vertex *ord;
+  Vertex *nyc;
+
+  void SetUp() {
+    g = Graph();
+    sfo = new Vertex("SFO");
+    den = new Vertex("DEN");
+    ord = new Vertex("ORD");
+    nyc = new Vertex("NYC");
+    g.addVertex(sfo);
+    g.addVertex(den);
+    g.addVertex(ord);
+    g.addVertex(nyc);
+
+    // Direct: $900, 300m; via DEN: $300, 420m; via ORD: $700, 350m
+    g.addDirectedEdge(sfo, nyc, 900, 300);
+    g.addDirectedEdge(sfo, den, 150, 180);
+    g.addDirectedEdge(den, nyc, 150, 240);
+    g.addDirectedEdge(sfo, ord, 400, 200);
+    g.addDirectedEdge(ord, nyc, 300, 150);
+  }
+
+  // Best objective over all simple paths from u within budget, by
+  // exhaustive search
+  int bruteForce(const CompactGraph &compact, int u, int target,
+                 SearchCriteria objective, SearchCriteria limited, int budget,
+                 std::vector<bool> &onPath) {
+    if (u == target) {
+      return 0;
+    }
+    int best = UNREACHABLE;
+    onPath[u] = true;
+    for (int arc = compact.begin(u); arc < compact.end(u); arc++) {
+      int v = compact.targets[arc];
+      int spend = compact.weight(arc, limited);
+      if (onPath[v] || spend > budget) {
+        continue;
+      }
+      int rest = bruteForce(compact, v, target, objective, limited,
+                            budget - spend, onPath);
+      if (rest != UNREACHABLE) {
+        best = std::min(best, rest + compact.weight(arc, objective));
+      }
+    }
+    onPath[u] = false;
+    return best;
+  }
+
+  Spec(FastestUnderAFareBudget) {
+    std::shared_ptr<Waypoint> result =
+        g.searchConstrained(sfo, nyc, FASTEST, CHEAPEST, 800);
+    Assert::That(result->totalTime, Equals(350));
+    Assert::That(result->totalCost, Equals(700));
+
+    result = g.searchConstrained(sfo, nyc, FASTEST, CHEAPEST, 1000);
+    Assert::That(result->totalTime, Equals(300));
+  }
+
+  Spec(CheapestUnderATimeBudget) {
+    std::shared_ptr<Waypoint> result =
+        g.searchConstrained(sfo, nyc, CHEAPEST, FASTEST, 400);
+    Assert::That(result->totalCost, Equals(700));
+    Assert::That(result->partialCost, Equals(700));
+  }
+
+  Spec(NullWhenNothingFits) {
+    Assert::That(g.searchConstrained(sfo, nyc, FASTEST, CHEAPEST, 299),
+                 IsNull());
+    Assert::That(g.searchConstrained(nyc, sfo, FASTEST, CHEAPEST, 5000),
+                 IsNull());
+  }
+
+  Spec(RejectsBudgetOnTheObjective) {
+    AssertThrows(std::logic_error,
+                 g.searchConstrained(sfo, nyc, CHEAPEST, CHEAPEST, 100));
+  }
+
+  Spec(MatchesExhaustiveSearch) {
+    CompactGraph compact = randomCompactGraph(20, 12, 3, 450, 330);
+
+    ConstrainedSearch search;
+    std::vector<bool> onPath(12, false);
+    for (int target = 1; target < 12; target++) {
+      for (int budget : {200, 500, 900, 2000}) {
+        search.run(compact, 0, target, FASTEST, CHEAPEST, budget);
+        int expected =
+            bruteForce(compact, 0, target, FASTEST, CHEAPEST, budget, onPath);
+        Assert::That(search.objective(), Equals(expected));
+        if (search.foundPath()) {
+          Assert::That(search.resource() <= budget, IsTrue());
+          int time = 0;
+          for (int arc : search.pathArcs()) {
+            time += compact.durations[arc];
+          }
+          Assert::That(time, Equals(expected));
+        }
+      }
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef TEST_CONTRACTION_HIERARCHY_H
+#define TEST_CONTRACTION_HIERARCHY_H
+
+#include <Graph.h>
+#include <igloo/igloo.h>
+#include <random>
+
+using namespace igloo;
+
+// =============================================================================
+// Contraction Hierarchy Tests
+// Tests for shortcut preprocessing and unpacked hierarchy queries
+// =============================================================================
+Context(ContractionHierarchyTests) {
+  Graph g;
+  std::vector<Vertex *> vs;
+
+  void SetUp() {
+    // Random network of 60 airports with two-way routes
+    g = Graph();
+    vs.clear();
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> pick(0, 59);
+    std::uniform_int_distribution<int> fare(50, 900);
+    std::uniform_int_distribution<int> minutes(40, 600);
+
+    for (int i = 0; i < 60; i++) {
+      vs.push_back(new Vertex("V" + std::to_string(i)));
+      g.addVertex(vs.back());
+    }
+    for (int i = 1; i < 60; i++) {
+      g.addEdge(vs[i - 1], vs[i], fare(rng), minutes(rng));
+    }
+    for (int i = 0; i < 100; i++) {
+      g.addDirectedEdge(vs[pick(rng)], vs[pick(rng)], fare(rng), minutes(rng));
+    }
+  }
+
+  Spec(DistancesMatchDijkstra) {
+    const CompactGraph &compact = g.freeze();
+    SearchCriteria modes[] = {CHEAPEST, FASTEST};
+    for (SearchCriteria mode : modes) {
+      ContractionHierarchy ch(compact, mode);
+      Dijkstra reference;
+      for (int s = 0; s < 60; s += 6) {
+        reference.run(compact, s, -1, mode);
+        for (int t = 0; t < 60; t++) {
+          Assert::That(ch.distance(s, t), Equals(reference.distance(t)));
+        }
+      }
+    }
+  }
+
+  Spec(UnpackedPathIsOptimalItinerary) {
+    ContractionHierarchy ch(g.freeze(), CHEAPEST);
+    for (int t = 1; t < 60; t += 7) {
+      std::shared_ptr<Waypoint> expected = g.search(vs[0], vs[t], CHEAPEST);
+      std::shared_ptr<Waypoint> result = g.searchHierarchy(vs[0], vs[t], ch);
+      Assert::That(result != nullptr);
+      Assert::That(result->vertex == vs[t], IsTrue());
+      Assert::That(result->totalCost, Equals(expected->totalCost));
+      Assert::That(result->partialCost, Equals(expected->partialCost));
+    }
+  }
+
+  Spec(RanksArePermutation) {
+    ContractionHierarchy ch(g.freeze(), FASTEST);
+    std::vector<bool> used(60, false);
+    for (int v = 0; v < 60; v++) {
+      Assert::That((bool)used[ch.rank(v)], IsFalse());
+      used[ch.rank(v)] = true;
+    }
+  }
+
+  Spec(ShortcutBypassesContractedMiddle) {
+    // A path of three: contracting the middle needs one shortcut each way
+    Graph p;
+    Vertex *a = new Vertex("A");
+    Vertex *b = new Vertex("B");
+    Vertex *c = new Vertex("C");
+    p.addVertex(a);
+    p.addVertex(b);
+    p.addVertex(c);
+    p.addEdge(a, b, 10, 1);
+    p.addEdge(b, c, 20, 1);
+
+    ContractionHierarchy ch(p.freeze(), CHEAPEST);
+    Assert::That(ch.distance(a->id, c->id), Equals(30));
+    std::shared_ptr<Waypoint> result = p.searchHierarchy(a, c, ch);
+    Assert::That(result->parent->vertex->data, Equals("B"));
+    Assert::That(result->totalCost, Equals(30));
+  }
+
+  Spec(UnreachableTarget) {
+    Vertex *isolated = new Vertex("Isolated");
+    g.addVertex(isolated);
+    ContractionHierarchy ch(g.freeze(), CHEAPEST);
+    Assert::That(ch.distance(0, isolated->id), Equals(UNREACHABLE));
+    Assert::That(g.searchHierarchy(vs[0], isolated, ch) == nullptr);
+  }
+
+  Spec(StaleHierarchyRejected) {
+    ContractionHierarchy ch(g.freeze(), CHEAPEST);
+    g.addDirectedEdge(vs[0], vs[59], 1, 1);
+    AssertThrows(std::logic_error, g.searchHierarchy(vs[0], vs[59], ch));
+  }
+};
+
+#endif // TEST_CONTRACTION_HIERARCHY_H
@@ -0,0 +1,70 @@
+#ifndef TEST_DELTA_STEPPING_H
+#define TEST_DELTA_STEPPING_H
+
+#include "fixtures.h"
+#include <DeltaStepping.h>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// Delta Stepping Tests
+// Tests for parallel one-to-all shortest paths checked against Dijkstra
+// =============================================================================
+Context(DeltaSteppingTests) {
+  CompactGraph g;
+
+  void SetUp() { g = randomCompactGraph(15, 3000, 4, 200); }
+
+  void checkAgainstDijkstra(DeltaStepping & ds, SearchCriteria criteria) {
+    ds.run(g, 7, criteria);
+    checkTreeAgainstDijkstra(g, ds, 7, criteria);
+  }
+
+  Spec(MatchesDijkstraWithAutomaticDelta) {
+    DeltaStepping ds(0, 4);
+    checkAgainstDijkstra(ds, CHEAPEST);
+    Assert::That(ds.bucketWidth() > 0, IsTrue());
+  }
+
+  Spec(MatchesDijkstraForAnyDelta) {
+    for (int delta : {1, 17, 100, 100000}) {
+      DeltaStepping ds(delta, 3);
+      checkAgainstDijkstra(ds, FASTEST);
+    }
+  }
+
+  Spec(UnitWeightsAreBreadthFirst) {
+    DeltaStepping ds(1, 2);
+    checkAgainstDijkstra(ds, LEAST_STOPS);
+  }
+
+  Spec(TreeIsDeterministic) {
+    DeltaStepping serial(50, 1);
+    DeltaStepping parallel(50, 4);
+    serial.run(g, 0, CHEAPEST);
+    parallel.run(g, 0, CHEAPEST);
+    for (int v = 0; v < g.vertexCount(); v++) {
+      Assert::That(parallel.arcTo(v), Equals(serial.arcTo(v)));
+    }
+  }
+
+  Spec(PathArcsReachTarget) {
+    DeltaStepping ds;
+    ds.run(g, 0, CHEAPEST);
+    for (int v = 0; v < 50; v++) {
+      int u = 0;
+      int total = 0;
+      for (int arc : ds.pathArcs(v)) {
+        total += g.costs[arc];
+        u = g.targets[arc];
+      }
+      if (ds.reached(v)) {
+        Assert::That(u, Equals(v));
+        Assert::That(total, Equals(ds.distance(v)));
+      }
+    }
+  }
+};
+
+#endif
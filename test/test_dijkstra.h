@@ -0,0 +1,69 @@
+#ifndef TEST_DIJKSTRA_H
+#define TEST_DIJKSTRA_H
+
+#include <Dijkstra.h>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// Dijkstra Engine Tests
+// Tests for the reusable shortest path engine over a CompactGraph
+// =============================================================================
+Context(DijkstraTests) {
+  CompactGraph g;
+  Dijkstra engine;
+
+  void SetUp() {
+    // 0 -> 1 ($4), 0 -> 2 ($1), 2 -> 1 ($2), 1 -> 3 ($5), 4 isolated
+    g = CompactGraph();
+    g.addVertex();
+    g.addArc(1, 4, 1);
+    g.addArc(2, 1, 1);
+    g.addVertex();
+    g.addArc(3, 5, 1);
+    g.addVertex();
+    g.addArc(1, 2, 1);
+    g.addVertex();
+    g.addVertex();
+  }
+
+  Spec(OneToAllDistances) {
+    engine.run(g, 0, -1, CHEAPEST);
+    Assert::That(engine.distance(0), Equals(0));
+    Assert::That(engine.distance(1), Equals(3));
+    Assert::That(engine.distance(2), Equals(1));
+    Assert::That(engine.distance(3), Equals(8));
+    Assert::That(engine.distance(4), Equals(UNREACHABLE));
+  }
+
+  Spec(PathArcsFollowParents) {
+    engine.run(g, 0, 3, CHEAPEST);
+    std::vector<int> arcs = engine.pathArcs(3);
+    Assert::That(arcs.size(), Equals(3u));
+    Assert::That(engine.parentOf(1), Equals(2));
+    Assert::That(engine.parentOf(0), Equals(-1));
+  }
+
+  Spec(LeastStopsCountsArcs) {
+    engine.run(g, 0, -1, LEAST_STOPS);
+    Assert::That(engine.distance(1), Equals(1));
+    Assert::That(engine.distance(3), Equals(2));
+  }
+
+  Spec(StopsAtTarget) {
+    engine.run(g, 0, 2, CHEAPEST);
+    Assert::That(engine.settled(2), IsTrue());
+    Assert::That(engine.settled(3), IsFalse());
+  }
+
+  Spec(RerunForgetsPreviousQuery) {
+    engine.run(g, 0, -1, CHEAPEST);
+    engine.run(g, 3, -1, CHEAPEST);
+    Assert::That(engine.distance(3), Equals(0));
+    Assert::That(engine.reached(0), IsFalse());
+    Assert::That(engine.distance(1), Equals(UNREACHABLE));
+  }
+};
+
+#endif // TEST_DIJKSTRA_H
@@ -0,0 +1,86 @@
+#ifndef TEST_DIRECTION_OPTIMIZING_BFS_H
+#define TEST_DIRECTION_OPTIMIZING_BFS_H
+
+#include "fixtures.h"
+#include <DirectionOptimizingBfs.h>
+#include <Graph.h>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// Direction Optimizing BFS Tests
+// Tests for fewest-stops search checked against Dijkstra
+// =============================================================================
+Context(DirectionOptimizingBfsTests) {
+  CompactGraph g;
+
+  void SetUp() { g = randomCompactGraph(17, 2000, 8, 300); }
+
+  void checkAgainstDijkstra(DirectionOptimizingBfs & bfs) {
+    bfs.run(g, 5);
+    checkTreeAgainstDijkstra(g, bfs, 5, LEAST_STOPS);
+  }
+
+  Spec(TopDownMatchesDijkstra) {
+    DirectionOptimizingBfs bfs(DirectionOptimizingBfs::TOP_DOWN);
+    checkAgainstDijkstra(bfs);
+    Assert::That(bfs.bottomUpLevels(), Equals(0));
+  }
+
+  Spec(BottomUpMatchesDijkstra) {
+    DirectionOptimizingBfs bfs(DirectionOptimizingBfs::BOTTOM_UP);
+    checkAgainstDijkstra(bfs);
+    Assert::That(bfs.bottomUpLevels(), Equals(bfs.levels()));
+  }
+
+  Spec(AutomaticSwitchesOnTheWideLevels) {
+    DirectionOptimizingBfs bfs;
+    checkAgainstDijkstra(bfs);
+    Assert::That(bfs.bottomUpLevels() > 0, IsTrue());
+    Assert::That(bfs.bottomUpLevels() < bfs.levels(), IsTrue());
+  }
+
+  Spec(BottomUpScansFewerArcs) {
+    DirectionOptimizingBfs topDown(DirectionOptimizingBfs::TOP_DOWN);
+    DirectionOptimizingBfs automatic;
+    topDown.run(g, 5);
+    automatic.run(g, 5);
+    Assert::That(automatic.stats().relaxed < topDown.stats().relaxed,
+                 IsTrue());
+  }
+
+  Spec(StopsAtTheTarget) {
+    DirectionOptimizingBfs bfs;
+    int target = g.targets[g.begin(5)];
+    bfs.run(g, 5, target);
+    Assert::That(bfs.distance(target), Equals(1));
+    Assert::That(bfs.pathArcs(target).size(), Equals(1u));
+    Assert::That(bfs.levels(), Equals(1));
+  }
+
+  Spec(GraphSearchUsesFewestStops) {
+    Graph graph;
+    Vertex *a = new Vertex("A");
+    Vertex *b = new Vertex("B");
+    Vertex *c = new Vertex("C");
+    Vertex *d = new Vertex("D");
+    graph.addVertex(a);
+    graph.addVertex(b);
+    graph.addVertex(c);
+    graph.addVertex(d);
+    graph.addDirectedEdge(a, b, 10, 10);
+    graph.addDirectedEdge(b, c, 10, 10);
+    graph.addDirectedEdge(c, d, 10, 10);
+    graph.addDirectedEdge(a, d, 500, 500);
+
+    SearchStats stats;
+    std::shared_ptr<Waypoint> result = graph.search(a, d, LEAST_STOPS, &stats);
+    Assert::That(result->stops, Equals(1));
+    Assert::That(result->totalCost, Equals(500));
+    Assert::That(stats.queries, Equals(1));
+    Assert::That(graph.search(d, a, LEAST_STOPS), IsNull());
+  }
+};
+
+#endif
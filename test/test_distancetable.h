@@ -0,0 +1,82 @@
+#ifndef TEST_DISTANCE_TABLE_H
+#define TEST_DISTANCE_TABLE_H
+
+#include "fixtures.h"
+#include <DistanceTable.h>
+#include <Graph.h>
+#include <cstdlib>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// Distance Table Tests
+// Tests for the multithreaded many-to-many distance matrix
+// =============================================================================
+Context(DistanceTableTests) {
+  Graph g;
+  Vertex *a;
+  Vertex *b;
+  Vertex *c;
+  Vertex *d;
+
+  void SetUp() {
+    // A -> B ($4), A -> C ($1), C -> B ($2), B -> D ($5), D isolated out
+    g = Graph();
+    a = new Vertex("A");
+    b = new Vertex("B");
+    c = new Vertex("C");
+    d = new Vertex("D");
+    g.addVertex(a);
+    g.addVertex(b);
+    g.addVertex(c);
+    g.addVertex(d);
+    g.addDirectedEdge(a, b, 4, 60);
+    g.addDirectedEdge(a, c, 1, 60);
+    g.addDirectedEdge(c, b, 2, 60);
+    g.addDirectedEdge(b, d, 5, 60);
+  }
+
+  Spec(FillsEveryPair) {
+    DistanceTable table = g.distanceTable({a, c}, {b, d, a}, CHEAPEST, 2);
+    Assert::That(table.rows, Equals(2));
+    Assert::That(table.cols, Equals(3));
+    Assert::That(table.at(0, 0), Equals(3));
+    Assert::That(table.at(0, 1), Equals(8));
+    Assert::That(table.at(0, 2), Equals(0));
+    Assert::That(table.at(1, 0), Equals(2));
+    Assert::That(table.at(1, 2), Equals(UNREACHABLE));
+  }
+
+  Spec(UnknownAirportIsUnreachable) {
+    Vertex outsider("X");
+    DistanceTable table = g.distanceTable({&outsider, a}, {b, &outsider},
+                                          CHEAPEST, 1);
+    Assert::That(table.at(0, 0), Equals(UNREACHABLE));
+    Assert::That(table.at(1, 0), Equals(3));
+    Assert::That(table.at(1, 1), Equals(UNREACHABLE));
+  }
+
+  Spec(ThreadedMatchesSingleSearches) {
+    CompactGraph cg = randomCompactGraph(13, 200, 4, 50, 50);
+    std::vector<int> sources;
+    std::vector<int> targets;
+    for (int i = 0; i < 40; i++) {
+      sources.push_back(rand() % 200);
+      targets.push_back(rand() % 200);
+    }
+
+    ManyToMany m2m;
+    DistanceTable table = m2m.run(cg, sources, targets, FASTEST, 4);
+    Dijkstra engine;
+    for (int i = 0; i < 40; i++) {
+      engine.run(cg, sources[i], -1, FASTEST);
+      for (int j = 0; j < 40; j++) {
+        Assert::That(table.at(i, j), Equals(engine.distance(targets[j])));
+      }
+    }
+    Assert::That(m2m.stats().settled > 0, IsTrue());
+  }
+};
+
+#endif
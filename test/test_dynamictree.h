@@ -0,0 +1,149 @@
+#ifndef TEST_DYNAMIC_TREE_H
+#define TEST_DYNAMIC_TREE_H
+
+#include "fixtures.h"
+#include <DynamicTree.h>
+#include <Graph.h>
+#include <cstdlib>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// Dynamic Tree Tests
+// Tests for shortest path trees repaired after arc weight changes
+// =============================================================================
+Context(DynamicTreeTests) {
+  CompactGraph g;
+
+  void SetUp() { g = randomCompactGraph(21, 400, 3); }
+
+  void checkAgainstDijkstra(const DynamicTree &tree) {
+    checkTreeAgainstDijkstra(g, tree, tree.source(), tree.criteria());
+  }
+
+  Spec(RepairsAfterEveryChange) {
+    DynamicTree tree;
+    tree.build(g, 0, CHEAPEST);
+    checkAgainstDijkstra(tree);
+
+    for (int step = 0; step < 200; step++) {
+      // Favour tree arcs, the ones whose changes need work
+      int arc = rand() % g.arcCount();
+      if (step % 2 == 0) {
+        int v = rand() % g.vertexCount();
+        if (tree.arcTo(v) != -1) {
+          arc = tree.arcTo(v);
+        }
+      }
+      int old = g.costs[arc];
+      int cost = std::max(0, old + rand() % 400 - 200);
+      g.setArc(arc, cost, g.durations[arc]);
+      tree.arcChanged(g, arc, old);
+      checkAgainstDijkstra(tree);
+    }
+  }
+
+  Spec(RepairTouchesOnlyTheAffectedVertices) {
+    DynamicTree tree;
+    tree.build(g, 0, FASTEST);
+    int full = tree.stats().settled;
+
+    int leaf = -1;
+    for (int v = 0; v < g.vertexCount() && leaf == -1; v++) {
+      bool parent = false;
+      for (int w = 0; w < g.vertexCount(); w++) {
+        parent = parent || tree.parentOf(w) == v;
+      }
+      if (!parent && tree.arcTo(v) != -1) {
+        leaf = v;
+      }
+    }
+    int arc = tree.arcTo(leaf);
+    int old = g.durations[arc];
+    g.setArc(arc, g.costs[arc], old + 1000);
+    Assert::That(tree.arcChanged(g, arc, old), Equals(1));
+    Assert::That(tree.stats().settled <= 1, IsTrue());
+    Assert::That(full > 100, IsTrue());
+    checkAgainstDijkstra(tree);
+  }
+
+  Spec(SetArcKeepsMaximaAndBounds) {
+    int arc = 0;
+    for (int a = 0; a < g.arcCount(); a++) {
+      if (g.costs[a] == g.maxCost) {
+        arc = a;
+      }
+    }
+    g.setArc(arc, 0, g.durations[arc]);
+    int highest = 0;
+    for (int a = 0; a < g.arcCount(); a++) {
+      highest = std::max(highest, g.costs[a]);
+    }
+    Assert::That(g.maxCost, Equals(highest));
+    Assert::That(g.costPerUnit, Equals(0.0));
+  }
+
+  Spec(GraphRepairsCachedTrees) {
+    Graph graph;
+    Vertex *a = new Vertex("A");
+    Vertex *b = new Vertex("B");
+    Vertex *c = new Vertex("C");
+    graph.addVertex(a);
+    graph.addVertex(b);
+    graph.addVertex(c);
+    graph.addDirectedEdge(a, b, 100, 60);
+    graph.addDirectedEdge(b, c, 100, 60);
+    graph.addDirectedEdge(a, c, 300, 90);
+
+    Assert::That(graph.searchCached(a, c, CHEAPEST)->totalCost, Equals(200));
+    const CompactGraph *before = &graph.freeze();
+    long version = graph.version;
+
+    graph.updateEdge(a->edgeList[0], 250, 60);
+    Assert::That(graph.version, Equals(version + 1));
+    Assert::That(graph.freeze().version, Equals(graph.version));
+    Assert::That(&graph.freeze() == before, IsTrue());
+    Assert::That(graph.freeze().costs[0], Equals(250));
+
+    SearchStats stats;
+    std::shared_ptr<Waypoint> route = graph.searchCached(a, c, CHEAPEST,
+                                                         &stats);
+    Assert::That(route->totalCost, Equals(300));
+    Assert::That(stats.settled, Equals(0));
+    Assert::That(graph.search(a, c, CHEAPEST)->totalCost, Equals(300));
+  }
+
+  Spec(GraphKeepsCachedStopTreesAcrossUpdates) {
+    Graph graph;
+    Vertex *a = new Vertex("A");
+    Vertex *b = new Vertex("B");
+    Vertex *c = new Vertex("C");
+    graph.addVertex(a);
+    graph.addVertex(b);
+    graph.addVertex(c);
+    graph.addDirectedEdge(a, b, 100, 0);
+    graph.addDirectedEdge(b, c, 100, 60);
+
+    Assert::That(graph.searchCached(a, c, LEAST_STOPS)->stops, Equals(2));
+    graph.updateEdge(a->edgeList[0], 50, 90);
+
+    SearchStats stats;
+    std::shared_ptr<Waypoint> route =
+        graph.searchCached(a, c, LEAST_STOPS, &stats);
+    Assert::That(route->stops, Equals(2));
+    Assert::That(route->totalCost, Equals(150));
+    Assert::That(stats.settled, Equals(0));
+  }
+
+  Spec(GraphRejectsForeignEdges) {
+    Graph graph;
+    Vertex *a = new Vertex("A");
+    graph.addVertex(a);
+    Vertex outside("X");
+    Edge e(&outside, a, 1, 1);
+    AssertThrows(std::logic_error, graph.updateEdge(&e, 5, 5));
+  }
+};
+
+#endif
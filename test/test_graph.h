@@ -79,6 +79,24 @@ Context(GraphTests) {
     Assert::That(result->parent->vertex->data, Equals("A"));
   }
 
+  Spec(CheaperRouteFoundLater) {
+    // A -> C directly is queued first at $150 and then improved via B
+    g.addDirectedEdge(v1, v3, 150, 1);
+
+    std::shared_ptr<Waypoint> result = g.search(v1, v3, CHEAPEST);
+    Assert::That(result != nullptr);
+    Assert::That(result->totalCost, Equals(20));
+    Assert::That(result->totalTime, Equals(40));
+    Assert::That(result->stops, Equals(2));
+    Assert::That(result->partialCost, Equals(20));
+    Assert::That(result->parent->vertex->data, Equals("B"));
+  }
+
+  Spec(VertexNotInGraph) {
+    Vertex outsider("Outsider");
+    Assert::That(g.search(v1, &outsider, CHEAPEST) == nullptr);
+  }
+
   Spec(NoPath) {
     Vertex *isolated = new Vertex("Isolated");
     g.addVertex(isolated);
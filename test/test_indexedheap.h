@@ -0,0 +1,81 @@
+#ifndef TEST_INDEXED_HEAP_H
+#define TEST_INDEXED_HEAP_H
+
+#include <IndexedHeap.h>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// Indexed Heap Tests
+// Tests for the decrease-key priority queue used by Graph::search
+// =============================================================================
+Context(IndexedHeapTests) {
+  IndexedHeap<int> h;
+
+  void SetUp() { h = IndexedHeap<int>(8); }
+
+  Spec(InitiallyEmpty) {
+    Assert::That(h.isEmpty(), IsTrue());
+    Assert::That(h.size(), Equals(0));
+    Assert::That(h.capacity(), Equals(8));
+  }
+
+  Spec(PopsInKeyOrder) {
+    h.push(0, 50);
+    h.push(1, 10);
+    h.push(2, 40);
+    h.push(3, 20);
+    h.push(4, 30);
+    Assert::That(h.pop(), Equals(1));
+    Assert::That(h.pop(), Equals(3));
+    Assert::That(h.pop(), Equals(4));
+    Assert::That(h.pop(), Equals(2));
+    Assert::That(h.pop(), Equals(0));
+    Assert::That(h.isEmpty(), IsTrue());
+  }
+
+  Spec(DecreaseKeyMovesToFront) {
+    h.push(0, 5);
+    h.push(1, 7);
+    h.push(2, 9);
+    h.decreaseKey(2, 1);
+    Assert::That(h.top(), Equals(2));
+    Assert::That(h.topKey(), Equals(1));
+  }
+
+  Spec(PushOrDecreaseKeepsBetterKey) {
+    Assert::That(h.pushOrDecrease(3, 10), IsTrue());
+    Assert::That(h.pushOrDecrease(3, 12), IsFalse());
+    Assert::That(h.key(3), Equals(10));
+    Assert::That(h.pushOrDecrease(3, 4), IsTrue());
+    Assert::That(h.key(3), Equals(4));
+    Assert::That(h.size(), Equals(1));
+  }
+
+  Spec(ContainsTracksMembership) {
+    h.push(6, 1);
+    Assert::That(h.contains(6), IsTrue());
+    h.pop();
+    Assert::That(h.contains(6), IsFalse());
+  }
+
+  Spec(ClearEmptiesHeap) {
+    h.push(0, 1);
+    h.push(5, 2);
+    h.clear();
+    Assert::That(h.isEmpty(), IsTrue());
+    Assert::That(h.contains(5), IsFalse());
+  }
+
+  Spec(PopEmptyThrows) {
+    AssertThrows(std::logic_error, h.pop());
+  }
+
+  Spec(DuplicatePushThrows) {
+    h.push(1, 3);
+    AssertThrows(std::logic_error, h.push(1, 2));
+  }
+};
+
+#endif // TEST_INDEXED_HEAP_H
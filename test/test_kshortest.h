@@ -0,0 +1,127 @@
+#ifndef TEST_K_SHORTEST_H
+#define TEST_K_SHORTEST_H
+
+#include "fixtures.h"
+#include <Graph.h>
+#include <KShortestPaths.h>
+#include <algorithm>
+#include <igloo/igloo.h>
+#include <set>
+
+using namespace igloo;
+
+// =============================================================================
+// K Shortest Paths Tests
+// Tests for Yen's loopless k shortest paths
+// =============================================================================
+Context(KShortestPathsTests) {
+  Graph g;
+  Vertex *a;
+  Vertex *b;
+  Vertex *c;
+  Vertex *d;
+  Vertex *e;
+
+  void SetUp() {
+    g = Graph();
+    a = new Vertex("A");
+    b = new Vertex("B");
+    c = new Vertex("C");
+    d = new Vertex("D");
+    e = new Vertex("E");
+    g.addVertex(a);
+    g.addVertex(b);
+    g.addVertex(c);
+    g.addVertex(d);
+    g.addVertex(e);
+
+    // A-B-E 20, A-C-E 30, A-D-E 50, A-B-C-E 35
+    g.addDirectedEdge(a, b, 10, 60);
+    g.addDirectedEdge(b, e, 10, 60);
+    g.addDirectedEdge(a, c, 15, 60);
+    g.addDirectedEdge(c, e, 15, 60);
+    g.addDirectedEdge(a, d, 25, 60);
+    g.addDirectedEdge(d, e, 25, 60);
+    g.addDirectedEdge(b, c, 10, 60);
+  }
+
+  std::string route(std::shared_ptr<Waypoint> wp) {
+    std::string s;
+    for (; wp != nullptr; wp = wp->parent) {
+      s = wp->vertex->data + s;
+    }
+    return s;
+  }
+
+  // Costs of every simple source-target path, by exhaustive search
+  void allSimple(const CompactGraph &cg, int u, int target, int cost,
+                 std::vector<bool> &onPath, std::vector<int> &costs) {
+    if (u == target) {
+      costs.push_back(cost);
+      return;
+    }
+    onPath[u] = true;
+    for (int arc = cg.begin(u); arc < cg.end(u); arc++) {
+      if (!onPath[cg.targets[arc]]) {
+        allSimple(cg, cg.targets[arc], target, cost + cg.costs[arc], onPath,
+                  costs);
+      }
+    }
+    onPath[u] = false;
+  }
+
+  Spec(ListsRoutesCheapestFirst) {
+    std::vector<std::shared_ptr<Waypoint>> routes =
+        g.kShortest(a, e, CHEAPEST, 10);
+    Assert::That(routes.size(), Equals(4u));
+    Assert::That(route(routes[0]), Equals("ABE"));
+    Assert::That(route(routes[1]), Equals("ACE"));
+    Assert::That(route(routes[2]), Equals("ABCE"));
+    Assert::That(route(routes[3]), Equals("ADE"));
+    Assert::That(routes[2]->totalCost, Equals(35));
+  }
+
+  Spec(KLimitsRoutes) {
+    Assert::That(g.kShortest(a, e, CHEAPEST, 2).size(), Equals(2u));
+    Assert::That(g.kShortest(a, e, CHEAPEST, 0).size(), Equals(0u));
+  }
+
+  Spec(NoRouteGivesNothing) {
+    Assert::That(g.kShortest(e, a, CHEAPEST, 3).size(), Equals(0u));
+  }
+
+  Spec(MatchesExhaustiveSearch) {
+    CompactGraph cg = randomCompactGraph(9, 12, 3, 20);
+
+    std::vector<int> expected;
+    std::vector<bool> onPath(12, false);
+    allSimple(cg, 0, 11, 0, onPath, expected);
+    std::sort(expected.begin(), expected.end());
+
+    KShortestPaths yen;
+    const std::vector<KShortestPaths::Path> &paths =
+        yen.run(cg, 0, 11, CHEAPEST, 25);
+    Assert::That(paths.size(),
+                 Equals(std::min<std::size_t>(25, expected.size())));
+
+    std::set<std::vector<int>> distinct;
+    for (std::size_t i = 0; i < paths.size(); i++) {
+      Assert::That(paths[i].cost, Equals(expected[i]));
+      distinct.insert(paths[i].arcs);
+    }
+    Assert::That(distinct.size(), Equals(paths.size()));
+  }
+
+  Spec(ParallelMatchesSerial) {
+    std::vector<std::shared_ptr<Waypoint>> serial =
+        g.kShortest(a, e, CHEAPEST, 4, 1);
+    std::vector<std::shared_ptr<Waypoint>> parallel =
+        g.kShortest(a, e, CHEAPEST, 4, 4);
+    Assert::That(parallel.size(), Equals(serial.size()));
+    for (std::size_t i = 0; i < serial.size(); i++) {
+      Assert::That(route(parallel[i]), Equals(route(serial[i])));
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef TEST_LABEL_ARENA_H
+#define TEST_LABEL_ARENA_H
+
+#include <LabelArena.h>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// Label Arena Tests
+// Tests for index-linked search labels
+// =============================================================================
+Context(LabelArenaTests) {
+  CompactGraph g;
+
+  void SetUp() {
+    // 0 -> 1 ($5, 30m) -> 2 ($7, 45m)
+    g = CompactGraph();
+    g.addVertex();
+    g.addArc(1, 5, 30);
+    g.addVertex();
+    g.addArc(2, 7, 45);
+    g.addVertex();
+  }
+
+  Spec(ExtendAccumulatesTotals) {
+    LabelArena arena;
+    int a = arena.root(0);
+    int b = arena.extend(a, 0, g);
+    int c = arena.extend(b, 1, g);
+
+    Assert::That(arena[c].vertex, Equals(2));
+    Assert::That(arena[c].parent, Equals(b));
+    Assert::That(arena[c].cost, Equals(12));
+    Assert::That(arena[c].time, Equals(75));
+    Assert::That(arena[c].stops, Equals(2));
+  }
+
+  Spec(PathArcsInTravelOrder) {
+    LabelArena arena;
+    int c = arena.extend(arena.extend(arena.root(0), 0, g), 1, g);
+    std::vector<int> arcs = arena.pathArcs(c);
+    Assert::That(arcs.size(), Equals(2u));
+    Assert::That(arcs[0], Equals(0));
+    Assert::That(arcs[1], Equals(1));
+    Assert::That(arena.pathArcs(0).size(), Equals(0u));
+  }
+
+  Spec(ClearKeepsStorage) {
+    LabelArena arena;
+    arena.extend(arena.root(0), 0, g);
+    std::size_t held = arena.bytes();
+    arena.clear();
+    Assert::That(arena.size(), Equals(0));
+    Assert::That(arena.bytes(), Equals(held));
+  }
+};
+
+#endif
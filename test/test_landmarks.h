@@ -0,0 +1,153 @@
+#ifndef TEST_LANDMARKS_H
+#define TEST_LANDMARKS_H
+
+#include <Graph.h>
+#include <igloo/igloo.h>
+#include <random>
+#include <sstream>
+
+using namespace igloo;
+
+// =============================================================================
+// Landmark Tests
+// Tests for ALT landmark tables, their bounds and their storage
+// =============================================================================
+Context(LandmarkTests) {
+  Graph g;
+  std::vector<Vertex *> vs;
+
+  void SetUp() {
+    g = Graph();
+    vs.clear();
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> pick(0, 49);
+    std::uniform_int_distribution<int> fare(50, 900);
+    std::uniform_int_distribution<int> minutes(40, 600);
+
+    for (int i = 0; i < 50; i++) {
+      vs.push_back(new Vertex("V" + std::to_string(i)));
+      g.addVertex(vs.back());
+    }
+    for (int i = 0; i < 150; i++) {
+      g.addDirectedEdge(vs[pick(rng)], vs[pick(rng)], fare(rng), minutes(rng));
+    }
+  }
+
+  Spec(SelectsDistinctLandmarks) {
+    Landmarks lm(g.freeze(), 8);
+    Assert::That(lm.count(), Equals(8));
+    for (int i = 0; i < lm.count(); i++) {
+      for (int j = i + 1; j < lm.count(); j++) {
+        Assert::That(lm.landmark(i) == lm.landmark(j), IsFalse());
+      }
+    }
+  }
+
+  Spec(BoundsAreAdmissible) {
+    const CompactGraph &compact = g.freeze();
+    Landmarks lm(compact, 8);
+    Dijkstra engine;
+    SearchCriteria modes[] = {CHEAPEST, FASTEST, LEAST_STOPS};
+    for (SearchCriteria mode : modes) {
+      for (int s = 0; s < 50; s += 3) {
+        engine.run(compact, s, -1, mode);
+        for (int t = 0; t < 50; t++) {
+          int bound = lm.bound(s, t, mode);
+          if (engine.distance(t) == UNREACHABLE) {
+            continue;
+          }
+          Assert::That(bound == UNREACHABLE, IsFalse());
+          Assert::That(bound <= engine.distance(t), IsTrue());
+        }
+      }
+    }
+  }
+
+  Spec(ALTMatchesDijkstra) {
+    Landmarks lm(g.freeze(), 16);
+    SearchCriteria modes[] = {CHEAPEST, FASTEST, LEAST_STOPS};
+    for (SearchCriteria mode : modes) {
+      for (int t = 1; t < 50; t += 4) {
+        std::shared_ptr<Waypoint> expected = g.search(vs[0], vs[t], mode);
+        std::shared_ptr<Waypoint> result = g.astar(vs[0], vs[t], mode, lm);
+        Assert::That(result == nullptr, Equals(expected == nullptr));
+        if (expected) {
+          Assert::That(result->partialCost, Equals(expected->partialCost));
+        }
+      }
+    }
+  }
+
+  Spec(ProvesUnreachable) {
+    Vertex *island = new Vertex("Island");
+    g.addVertex(island);
+    Landmarks lm(g.freeze(), 4);
+    // The island is a landmark of its own and reaches nobody
+    Assert::That(lm.bound(island->id, vs[0]->id, CHEAPEST),
+                 Equals(UNREACHABLE));
+    Assert::That(g.astar(vs[0], island, CHEAPEST, lm) == nullptr);
+  }
+
+  Spec(SaveLoadRoundTrip) {
+    const CompactGraph &compact = g.freeze();
+    Landmarks lm(compact, 6);
+    std::stringstream ss;
+    lm.save(ss, compact);
+
+    Landmarks loaded;
+    Assert::That(loaded.load(ss, compact), IsTrue());
+    Assert::That(loaded.count(), Equals(6));
+    Assert::That(loaded.version, Equals(compact.version));
+    for (int v = 0; v < 50; v++) {
+      Assert::That(loaded.bound(v, 7, FASTEST),
+                   Equals(lm.bound(v, 7, FASTEST)));
+    }
+  }
+
+  Spec(LoadRejectsOtherGraph) {
+    Landmarks lm(g.freeze(), 6);
+    std::stringstream ss;
+    lm.save(ss, g.freeze());
+
+    g.addDirectedEdge(vs[1], vs[2], 1, 1);
+    Landmarks loaded;
+    Assert::That(loaded.load(ss, g.freeze()), IsFalse());
+    Assert::That(loaded.count(), Equals(0));
+  }
+
+  Spec(LoadRejectsDamagedHeaders) {
+    const CompactGraph &compact = g.freeze();
+    Landmarks lm(compact, 6);
+    std::stringstream saved;
+    lm.save(saved, compact);
+    std::string tag;
+    int vertices;
+    int count;
+    std::string signature;
+    saved >> tag >> vertices >> count >> signature;
+    std::string rest((std::istreambuf_iterator<char>(saved)),
+                     std::istreambuf_iterator<char>());
+
+    // Landmark counts out of range, then a landmark id out of range
+    std::vector<std::string> damaged = {
+        "landmarks 50 -1 " + signature + rest,
+        "landmarks 50 0 " + signature + rest,
+        "landmarks 50 2000000000 " + signature + rest,
+        "landmarks 50 1 " + signature + "\n50\n" + rest,
+        "landmarks 50 1 " + signature + "\n-3\n" + rest};
+    for (const std::string &text : damaged) {
+      std::stringstream ss(text);
+      Landmarks loaded;
+      Assert::That(loaded.load(ss, compact), IsFalse());
+      Assert::That(loaded.count(), Equals(0));
+    }
+  }
+
+  Spec(StaleTablesRejected) {
+    Landmarks lm(g.freeze(), 4);
+    g.addDirectedEdge(vs[1], vs[2], 1, 1);
+    AssertThrows(std::logic_error, g.astar(vs[0], vs[2], CHEAPEST, lm));
+  }
+};
+
+#endif // TEST_LANDMARKS_H
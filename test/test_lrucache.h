@@ -0,0 +1,134 @@
+#ifndef TEST_LRU_CACHE_H
+#define TEST_LRU_CACHE_H
+
+#include <Graph.h>
+#include <LRUCache.h>
+#include <igloo/igloo.h>
+#include <string>
+
+using namespace igloo;
+
+// =============================================================================
+// LRU Cache Tests
+// Tests for the versioned query-result cache
+// =============================================================================
+Context(LRUCacheTests) {
+  Spec(FindsWhatWasInserted) {
+    LRUCache<int, std::string> cache(4);
+    cache.insert(1, "one", 0);
+    Assert::That(*cache.find(1, 0), Equals("one"));
+    Assert::That(cache.find(2, 0) == nullptr, IsTrue());
+    Assert::That(cache.hits(), Equals(1));
+    Assert::That(cache.misses(), Equals(1));
+  }
+
+  Spec(EvictsTheLeastRecentlyUsed) {
+    LRUCache<int, int> cache(2);
+    cache.insert(1, 10, 0);
+    cache.insert(2, 20, 0);
+    cache.find(1, 0);
+    cache.insert(3, 30, 0);
+    Assert::That(cache.size(), Equals(2));
+    Assert::That(cache.evictions(), Equals(1));
+    Assert::That(cache.find(2, 0) == nullptr, IsTrue());
+    Assert::That(*cache.find(1, 0), Equals(10));
+    Assert::That(*cache.find(3, 0), Equals(30));
+  }
+
+  Spec(NeverServesStaleEntries) {
+    LRUCache<int, int> cache(2);
+    cache.insert(1, 10, 5);
+    Assert::That(cache.find(1, 6) == nullptr, IsTrue());
+    Assert::That(cache.size(), Equals(0));
+    Assert::That(cache.evictions(), Equals(0));
+
+    cache.insert(1, 11, 6);
+    cache.insert(2, 20, 6);
+    Assert::That(*cache.find(1, 6), Equals(11));
+    Assert::That(cache.evictions(), Equals(0));
+  }
+
+  Spec(ReinsertingReplacesTheValue) {
+    LRUCache<int, int> cache(2);
+    cache.insert(1, 10, 0);
+    cache.insert(1, 12, 1);
+    Assert::That(cache.size(), Equals(1));
+    Assert::That(*cache.find(1, 1), Equals(12));
+  }
+
+  Spec(CopiesAreIndependent) {
+    LRUCache<int, int> cache(3);
+    cache.insert(1, 10, 0);
+    cache.insert(2, 20, 0);
+    LRUCache<int, int> copy = cache;
+    copy.insert(3, 30, 0);
+    copy.find(1, 0);
+    copy.insert(4, 40, 0);
+    Assert::That(copy.find(2, 0) == nullptr, IsTrue());
+    Assert::That(*cache.find(2, 0), Equals(20));
+    Assert::That(cache.size(), Equals(2));
+  }
+
+  Spec(GraphServesRepeatedRoutesFromCache) {
+    Graph g;
+    Vertex *a = new Vertex("A");
+    Vertex *b = new Vertex("B");
+    Vertex *c = new Vertex("C");
+    g.addVertex(a);
+    g.addVertex(b);
+    g.addVertex(c);
+    g.addDirectedEdge(a, b, 100, 60);
+    g.addDirectedEdge(b, c, 100, 60);
+    g.addDirectedEdge(a, c, 200, 200);
+
+    Assert::That(g.findRoutes(a, c, CHEAPEST).size(), Equals(2u));
+    SearchStats stats;
+    Assert::That(g.findRoutes(a, c, CHEAPEST, nullptr, &stats).size(),
+                 Equals(2u));
+    Assert::That(stats.settled, Equals(0));
+    Assert::That(g.routeCache().hits(), Equals(1));
+
+    // Any change to the graph retires the cached answer
+    g.updateEdge(a->edgeList[1], 150, 200);
+    std::vector<std::shared_ptr<Waypoint>> routes =
+        g.findRoutes(a, c, CHEAPEST);
+    Assert::That(routes.size(), Equals(1u));
+    Assert::That(routes[0]->totalCost, Equals(150));
+    Assert::That(g.routeCache().misses(), Equals(2));
+  }
+
+  Spec(GraphKeysConstrainedSearchesByBudget) {
+    Graph g;
+    Vertex *a = new Vertex("A");
+    Vertex *b = new Vertex("B");
+    g.addVertex(a);
+    g.addVertex(b);
+    g.addDirectedEdge(a, b, 500, 60);
+
+    Assert::That(g.searchConstrained(a, b, FASTEST, CHEAPEST, 400), IsNull());
+    Assert::That(g.searchConstrained(a, b, FASTEST, CHEAPEST, 600)->totalTime,
+                 Equals(60));
+    Assert::That(g.searchConstrained(a, b, FASTEST, CHEAPEST, 400), IsNull());
+    Assert::That(g.routeCache().hits(), Equals(1));
+    Assert::That(g.routeCache().size(), Equals(2));
+  }
+
+  Spec(GraphKeepsConstrainedAndPlainQueriesApart) {
+    Graph g;
+    Vertex *a = new Vertex("A");
+    Vertex *b = new Vertex("B");
+    g.addVertex(a);
+    g.addVertex(b);
+    g.addDirectedEdge(a, b, 100, 60);
+
+    // A zero budget under CHEAPEST must not share findRoutes()' key
+    Assert::That(g.searchConstrained(a, b, FASTEST, CHEAPEST, 0), IsNull());
+    Assert::That((int)g.findRoutes(a, b, FASTEST).size(), Equals(1));
+    Assert::That(g.searchConstrained(a, b, FASTEST, CHEAPEST, 0), IsNull());
+    Assert::That((int)g.findRoutes(a, b, FASTEST).size(), Equals(1));
+    Assert::That(g.routeCache().hits(), Equals(2));
+    Assert::That(g.routeCache().size(), Equals(2));
+  }
+};
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef TEST_OPTIMAL_PATHS_H
+#define TEST_OPTIMAL_PATHS_H
+
+#include <Graph.h>
+#include <igloo/igloo.h>
+#include <set>
+
+using namespace igloo;
+
+// =============================================================================
+// Optimal Paths Tests
+// Tests for counting and listing ties through the shortest path DAG
+// =============================================================================
+Context(OptimalPathsTests) {
+  Graph g;
+  Vertex *grid[4][4];
+
+  void SetUp() {
+    // 4x4 grid of one-way routes going right and down, every leg $10
+    g = Graph();
+    for (int r = 0; r < 4; r++) {
+      for (int c = 0; c < 4; c++) {
+        grid[r][c] = new Vertex(std::string(1, 'A' + r * 4 + c));
+        g.addVertex(grid[r][c]);
+      }
+    }
+    for (int r = 0; r < 4; r++) {
+      for (int c = 0; c < 4; c++) {
+        if (c + 1 < 4) {
+          g.addDirectedEdge(grid[r][c], grid[r][c + 1], 10, 10 + r);
+        }
+        if (r + 1 < 4) {
+          g.addDirectedEdge(grid[r][c], grid[r + 1][c], 10, 10 + c);
+        }
+      }
+    }
+  }
+
+  std::string route(std::shared_ptr<Waypoint> wp) {
+    std::string s;
+    for (; wp != nullptr; wp = wp->parent) {
+      s = wp->vertex->data + s;
+    }
+    return s;
+  }
+
+  Spec(CountsAllTies) {
+    // Every monotone lattice path costs $60: C(6, 3) of them
+    Assert::That(g.countOptimalPaths(grid[0][0], grid[3][3], CHEAPEST),
+                 Equals(20ull));
+  }
+
+  Spec(ListsEveryTieOnce) {
+    std::vector<std::shared_ptr<Waypoint>> paths =
+        g.searchAll(grid[0][0], grid[3][3], CHEAPEST);
+    Assert::That(paths.size(), Equals(20u));
+
+    std::set<std::string> distinct;
+    for (const auto &p : paths) {
+      Assert::That(p->totalCost, Equals(60));
+      Assert::That(p->stops, Equals(6));
+      distinct.insert(route(p));
+    }
+    Assert::That(distinct.size(), Equals(20u));
+  }
+
+  Spec(FirstPathMatchesSearch) {
+    std::shared_ptr<Waypoint> single =
+        g.search(grid[0][0], grid[3][3], CHEAPEST);
+    std::vector<std::shared_ptr<Waypoint>> paths =
+        g.searchAll(grid[0][0], grid[3][3], CHEAPEST);
+    Assert::That(route(paths[0]), Equals(route(single)));
+  }
+
+  Spec(LimitCapsResults) {
+    Assert::That(g.searchAll(grid[0][0], grid[3][3], CHEAPEST, 5).size(),
+                 Equals(5u));
+    Assert::That(g.searchAll(grid[0][0], grid[3][3], CHEAPEST, 0).size(),
+                 Equals(0u));
+  }
+
+  Spec(ListMatchesCountUnderOtherCriteria) {
+    // Durations grow with the row and column, so fewer routes tie
+    std::vector<std::shared_ptr<Waypoint>> paths =
+        g.searchAll(grid[0][0], grid[3][3], FASTEST);
+    Assert::That(paths.size(),
+                 Equals((std::size_t)g.countOptimalPaths(
+                     grid[0][0], grid[3][3], FASTEST)));
+    for (const auto &p : paths) {
+      Assert::That(p->totalTime, Equals(paths[0]->totalTime));
+    }
+  }
+
+  Spec(HugeCountWithoutMaterialising) {
+    // 30 layers of 4 airports, every airport flying to all of the next
+    Graph layered;
+    std::vector<Vertex *> prev;
+    Vertex *origin = new Vertex("Origin");
+    layered.addVertex(origin);
+    prev.push_back(origin);
+    for (int layer = 0; layer < 30; layer++) {
+      std::vector<Vertex *> next;
+      for (int i = 0; i < 4; i++) {
+        next.push_back(new Vertex("L" + std::to_string(layer * 4 + i)));
+        layered.addVertex(next.back());
+        for (Vertex *p : prev) {
+          layered.addDirectedEdge(p, next.back(), 1, 1);
+        }
+      }
+      prev = next;
+    }
+    Vertex *end = new Vertex("End");
+    layered.addVertex(end);
+    for (Vertex *p : prev) {
+      layered.addDirectedEdge(p, end, 1, 1);
+    }
+
+    unsigned long long expected = 1;
+    for (int i = 0; i < 30; i++) {
+      expected *= 4;
+    }
+    Assert::That(layered.countOptimalPaths(origin, end, CHEAPEST),
+                 Equals(expected));
+    Assert::That(layered.searchAll(origin, end, CHEAPEST, 3).size(),
+                 Equals(3u));
+  }
+
+  Spec(ZeroDurationLegsKeepEveryTie) {
+    // Fare-only routes take no time, so every simple route is fastest
+    Graph flat;
+    Vertex *v[5];
+    for (int i = 0; i < 5; i++) {
+      v[i] = new Vertex(std::string(1, 'A' + i));
+      flat.addVertex(v[i]);
+    }
+    flat.addEdge(v[0], v[1], 5);
+    flat.addEdge(v[1], v[2], 5);
+    flat.addEdge(v[0], v[3], 5);
+    flat.addEdge(v[3], v[2], 5);
+    flat.addEdge(v[1], v[3], 5);
+    flat.addEdge(v[2], v[4], 5);
+
+    std::vector<std::shared_ptr<Waypoint>> paths =
+        flat.searchAll(v[0], v[4], FASTEST);
+    std::set<std::string> distinct;
+    for (const auto &p : paths) {
+      Assert::That(p->totalTime, Equals(0));
+      distinct.insert(route(p));
+    }
+    Assert::That((int)paths.size(), Equals(4));
+    Assert::That((int)distinct.size(), Equals(4));
+    Assert::That(distinct.count("ABDCE") + distinct.count("ADBCE"),
+                 Equals(2u));
+    Assert::That(flat.countOptimalPaths(v[0], v[4], FASTEST), Equals(4ull));
+  }
+
+  Spec(ZeroDurationLegBetweenTies) {
+    // A and B tie, joined both ways by a leg taking no time
+    Graph tied;
+    Vertex *s = new Vertex("S");
+    Vertex *a = new Vertex("A");
+    Vertex *b = new Vertex("B");
+    Vertex *t = new Vertex("T");
+    tied.addVertex(s);
+    tied.addVertex(a);
+    tied.addVertex(b);
+    tied.addVertex(t);
+    tied.addDirectedEdge(s, a, 1, 1);
+    tied.addDirectedEdge(s, b, 1, 1);
+    tied.addDirectedEdge(a, b, 0, 0);
+    tied.addDirectedEdge(b, a, 0, 0);
+    tied.addDirectedEdge(a, t, 1, 1);
+    tied.addDirectedEdge(b, t, 1, 1);
+
+    std::set<std::string> distinct;
+    for (const auto &p : tied.searchAll(s, t, FASTEST)) {
+      distinct.insert(route(p));
+    }
+    Assert::That(distinct, Equals(std::set<std::string>{"SAT", "SBT", "SABT",
+                                                       "SBAT"}));
+    Assert::That(tied.countOptimalPaths(s, t, CHEAPEST), Equals(4ull));
+
+    // One way only, the ties form a DAG and are counted without listing
+    Graph oneWay;
+    oneWay.addVertex(s = new Vertex("S"));
+    oneWay.addVertex(a = new Vertex("A"));
+    oneWay.addVertex(b = new Vertex("B"));
+    oneWay.addVertex(t = new Vertex("T"));
+    oneWay.addDirectedEdge(s, a, 1, 1);
+    oneWay.addDirectedEdge(s, b, 1, 1);
+    oneWay.addDirectedEdge(b, a, 0, 0);
+    oneWay.addDirectedEdge(a, t, 1, 1);
+    oneWay.addDirectedEdge(b, t, 1, 1);
+    Assert::That(oneWay.countOptimalPaths(s, t, FASTEST), Equals(3ull));
+    Assert::That((int)oneWay.searchAll(s, t, FASTEST).size(), Equals(3));
+  }
+
+  Spec(NoPath) {
+    Assert::That(g.searchAll(grid[3][3], grid[0][0], CHEAPEST).empty(),
+                 IsTrue());
+    Assert::That(g.countOptimalPaths(grid[3][3], grid[0][0], CHEAPEST),
+                 Equals(0ull));
+  }
+};
+
+#endif // TEST_OPTIMAL_PATHS_H
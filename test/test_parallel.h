@@ -0,0 +1,47 @@
+#ifndef TEST_PARALLEL_H
+#define TEST_PARALLEL_H
+
+#include <Parallel.h>
+#include <igloo/igloo.h>
+#include <vector>
+
+using namespace igloo;
+
+// =============================================================================
+// Parallel Tests
+// Tests for the shared-counter parallel loop
+// =============================================================================
+Context(ParallelTests) {
+  Spec(VisitsEveryIndexOnce) {
+    std::vector<int> hits(1000, 0);
+    parallelFor(1000, 4, [&](int i, int worker) { hits[i]++; });
+    for (int i = 0; i < 1000; i++) {
+      Assert::That(hits[i], Equals(1));
+    }
+  }
+
+  Spec(WorkerIndexInRange) {
+    std::vector<int> workers(100, -1);
+    parallelFor(100, 3, [&](int i, int worker) { workers[i] = worker; });
+    for (int w : workers) {
+      Assert::That(w >= 0 && w < 3, IsTrue());
+    }
+  }
+
+  Spec(SingleWorkerRunsInOrder) {
+    std::vector<int> order;
+    parallelFor(5, 1, [&](int i, int worker) { order.push_back(i); });
+    Assert::That(order.size(), Equals(5u));
+    for (int i = 0; i < 5; i++) {
+      Assert::That(order[i], Equals(i));
+    }
+  }
+
+  Spec(EmptyRangeDoesNothing) {
+    int calls = 0;
+    parallelFor(0, 4, [&](int i, int worker) { calls++; });
+    Assert::That(calls, Equals(0));
+  }
+};
+
+#endif
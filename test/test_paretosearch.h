@@ -0,0 +1,111 @@
+#ifndef TEST_PARETO_SEARCH_H
+#define TEST_PARETO_SEARCH_H
+
+#include <Graph.h>
+#include <igloo/igloo.h>
+#include <random>
+
+using namespace igloo;
+
+// =============================================================================
+// Pareto Search Tests
+// Tests for the (cost, time, stops) non-dominated itinerary set
+// =============================================================================
+Context(ParetoSearchTests) {
+  Graph g;
+  Vertex *sfo;
+  Vertex *den;
+  Vertex *ord;
+  Vertex *nyc;
+
+  void SetUp() {
+    g = Graph();
+    sfo = new Vertex("SFO");
+    den = new Vertex("DEN");
+    ord = new Vertex("ORD");
+    nyc = new Vertex("NYC");
+    g.addVertex(sfo);
+    g.addVertex(den);
+    g.addVertex(ord);
+    g.addVertex(nyc);
+
+    // Direct: $500, 300m, 1 stop
+    g.addDirectedEdge(sfo, nyc, 500, 300);
+    // Via DEN: $300, 420m, 2 stops
+    g.addDirectedEdge(sfo, den, 150, 180);
+    g.addDirectedEdge(den, nyc, 150, 240);
+    // Via ORD: $350, 280m, 2 stops
+    g.addDirectedEdge(sfo, ord, 200, 140);
+    g.addDirectedEdge(ord, nyc, 150, 140);
+    // Via DEN and ORD: $600, 700m, 3 stops, dominated by everything
+    g.addDirectedEdge(den, ord, 300, 380);
+  }
+
+  Spec(ReturnsWholeFrontCheapestFirst) {
+    std::vector<std::shared_ptr<Waypoint>> front = g.searchPareto(sfo, nyc);
+    Assert::That(front.size(), Equals(3u));
+    Assert::That(front[0]->totalCost, Equals(300));
+    Assert::That(front[1]->totalCost, Equals(350));
+    Assert::That(front[2]->totalCost, Equals(500));
+    Assert::That(front[1]->totalTime, Equals(280));
+    Assert::That(front[2]->stops, Equals(1));
+  }
+
+  Spec(DominatedItineraryExcluded) {
+    for (const auto &wp : g.searchPareto(sfo, nyc)) {
+      Assert::That(wp->totalCost == 600, IsFalse());
+    }
+  }
+
+  Spec(ContainsSingleCriterionOptima) {
+    std::vector<std::shared_ptr<Waypoint>> front = g.searchPareto(sfo, nyc);
+    int cheapest = g.search(sfo, nyc, CHEAPEST)->totalCost;
+    int fastest = g.search(sfo, nyc, FASTEST)->totalTime;
+    int fewest = g.search(sfo, nyc, LEAST_STOPS)->stops;
+
+    bool hasCheapest = false, hasFastest = false, hasFewest = false;
+    for (const auto &wp : front) {
+      hasCheapest = hasCheapest || wp->totalCost == cheapest;
+      hasFastest = hasFastest || wp->totalTime == fastest;
+      hasFewest = hasFewest || wp->stops == fewest;
+    }
+    Assert::That(hasCheapest && hasFastest && hasFewest, IsTrue());
+  }
+
+  Spec(FrontIsMutuallyNonDominated) {
+    Graph r;
+    std::mt19937 rng(19);
+    std::uniform_int_distribution<int> pick(0, 39);
+    std::uniform_int_distribution<int> fare(50, 900);
+    std::uniform_int_distribution<int> minutes(40, 600);
+    std::vector<Vertex *> vs;
+    for (int i = 0; i < 40; i++) {
+      vs.push_back(new Vertex("V" + std::to_string(i)));
+      r.addVertex(vs.back());
+    }
+    for (int i = 0; i < 160; i++) {
+      r.addDirectedEdge(vs[pick(rng)], vs[pick(rng)], fare(rng), minutes(rng));
+    }
+
+    for (int t = 1; t < 40; t += 6) {
+      std::vector<std::shared_ptr<Waypoint>> front =
+          r.searchPareto(vs[0], vs[t]);
+      for (std::size_t i = 0; i < front.size(); i++) {
+        Assert::That(front[i]->vertex == vs[t], IsTrue());
+        for (std::size_t j = 0; j < front.size(); j++) {
+          bool dominates = i != j &&
+                           front[i]->totalCost <= front[j]->totalCost &&
+                           front[i]->totalTime <= front[j]->totalTime &&
+                           front[i]->stops <= front[j]->stops;
+          Assert::That(dominates, IsFalse());
+        }
+      }
+    }
+  }
+
+  Spec(NoPath) {
+    Assert::That(g.searchPareto(nyc, sfo).empty(), IsTrue());
+  }
+};
+
+#endif // TEST_PARETO_SEARCH_H
@@ -0,0 +1,145 @@
+#ifndef TEST_RAPTOR_H
+#define TEST_RAPTOR_H
+
+#include <ConnectionScan.h>
+#include <Graph.h>
+#include <Raptor.h>
+#include <cstdlib>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// RAPTOR Tests
+// Tests for arrival time versus transfers queries on route timetables
+// =============================================================================
+Context(RaptorTests) {
+  // A slow direct flight 0 -> 3 and a faster connection through 1 and 2
+  Timetable sample() {
+    Timetable tt(4, 30);
+    tt.addConnection(0, 3, 480, 900);
+    tt.addConnection(0, 1, 490, 560);
+    tt.addConnection(1, 2, 600, 650);
+    tt.addConnection(2, 3, 690, 760);
+    tt.addConnection(1, 3, 620, 800);
+    tt.sort();
+    return tt;
+  }
+
+  Timetable randomTimetable(int seed) {
+    srand(seed);
+    Timetable tt(60, 25);
+    for (int i = 0; i < 400; i++) {
+      int trip = tt.newTrip();
+      int from = rand() % 60;
+      int time = rand() % (20 * 60);
+      for (int leg = 0; leg < 1 + rand() % 3; leg++) {
+        int to = rand() % 60;
+        int arrival = time + 40 + rand() % 200;
+        tt.addConnection(from, to, time, arrival, 0, trip);
+        from = to;
+        time = arrival + 20;
+      }
+    }
+    tt.sort();
+    return tt;
+  }
+
+  Spec(FindsTheParetoSet) {
+    Timetable tt = sample();
+    RouteTimetable rt(tt);
+    Raptor raptor;
+    raptor.run(rt, 0, 400);
+
+    std::vector<RaptorArrival> front = raptor.arrivals(3);
+    Assert::That(front.size(), Equals(3u));
+    Assert::That(front[0].arrival, Equals(900));
+    Assert::That(front[0].transfers, Equals(0));
+    Assert::That(front[1].arrival, Equals(800));
+    Assert::That(front[1].transfers, Equals(1));
+    Assert::That(front[2].arrival, Equals(760));
+    Assert::That(front[2].transfers, Equals(2));
+    Assert::That(raptor.journey(rt, 3, 2).size(), Equals(3u));
+    Assert::That(tt[raptor.journey(rt, 3, 1)[1]].arrival, Equals(800));
+  }
+
+  Spec(CapsTheTransfers) {
+    Timetable tt = sample();
+    RouteTimetable rt(tt);
+    Raptor raptor;
+    raptor.run(rt, 0, 400, 1);
+    Assert::That(raptor.arrivals(3).back().arrival, Equals(800));
+    Assert::That(raptor.journey(rt, 3, 2).empty(), IsTrue());
+  }
+
+  Spec(MatchesConnectionScan) {
+    Timetable tt = randomTimetable(19);
+    RouteTimetable rt(tt);
+    Raptor raptor;
+    ConnectionScan csa;
+    raptor.run(rt, 4, 300, 30);
+    csa.run(tt, 4, 300);
+    for (int v = 0; v < 60; v++) {
+      if (v == 4) {
+        continue;
+      }
+      std::vector<RaptorArrival> front = raptor.arrivals(v);
+      int best = front.empty() ? UNREACHABLE : front.back().arrival;
+      Assert::That(best, Equals(csa.arrivalTime(v)));
+      for (std::size_t i = 1; i < front.size(); i++) {
+        Assert::That(front[i].arrival < front[i - 1].arrival, IsTrue());
+        Assert::That(front[i].transfers > front[i - 1].transfers, IsTrue());
+      }
+      if (!front.empty()) {
+        std::vector<int> legs = raptor.journey(rt, v, front[0].transfers);
+        Assert::That(tt[legs.front()].from, Equals(4));
+        Assert::That(tt[legs.back()].to, Equals(v));
+        Assert::That(tt[legs.back()].arrival, Equals(front[0].arrival));
+      }
+    }
+  }
+
+  Spec(RangeQueryMatchesSingleDepartures) {
+    Timetable tt = randomTimetable(20);
+    RouteTimetable rt(tt);
+    Raptor range;
+    Raptor single;
+    std::vector<RaptorArrival> profile =
+        range.rangeQuery(rt, 4, 17, 0, 24 * 60, 3);
+    Assert::That(profile.empty(), IsFalse());
+
+    for (const RaptorArrival &entry : profile) {
+      single.run(rt, 4, entry.departure, 3);
+      int best = UNREACHABLE;
+      for (const RaptorArrival &a : single.arrivals(17)) {
+        if (a.transfers <= entry.transfers) {
+          best = a.arrival;
+        }
+      }
+      Assert::That(best, Equals(entry.arrival));
+    }
+
+    std::vector<RaptorArrival> parallel =
+        range.rangeQuery(rt, 4, 17, 0, 24 * 60, 3, 3);
+    Assert::That(parallel.size(), Equals(profile.size()));
+    for (std::size_t i = 0; i < profile.size(); i++) {
+      Assert::That(parallel[i].departure, Equals(profile[i].departure));
+      Assert::That(parallel[i].arrival, Equals(profile[i].arrival));
+      Assert::That(parallel[i].transfers, Equals(profile[i].transfers));
+    }
+  }
+
+  Spec(GraphAnswersFromTheRouteTimetable) {
+    Graph g;
+    for (const char *code : {"SFO", "DEN", "ORD", "NYC"}) {
+      g.addVertex(new Vertex(code));
+    }
+    RouteTimetable rt(sample());
+    std::vector<RaptorArrival> front =
+        g.arrivalsByTransfers(g.vertices[0], g.vertices[3], 400, rt, 1);
+    Assert::That(front.size(), Equals(2u));
+    Assert::That(front[1].arrival, Equals(800));
+  }
+};
+
+#endif
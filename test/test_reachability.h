@@ -0,0 +1,147 @@
+#ifndef TEST_REACHABILITY_H
+#define TEST_REACHABILITY_H
+
+#include "fixtures.h"
+#include <Graph.h>
+#include <Reachability.h>
+#include <cstdlib>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// Reachability Tests
+// Tests for the component closure that rules out unreachable pairs
+// =============================================================================
+Context(ReachabilityTests) {
+  CompactGraph g;
+
+  // Sparse enough to leave many vertices outside each other's reach
+  void SetUp() { g = randomCompactGraph(24, 200, 1); }
+
+  // Everything reachable from s in g, by a plain breadth-first search
+  std::vector<bool> reachableFrom(const CompactGraph &graph, int s) {
+    std::vector<bool> seen(graph.vertexCount(), false);
+    std::vector<int> queue(1, s);
+    seen[s] = true;
+    for (std::size_t i = 0; i < queue.size(); i++) {
+      int u = queue[i];
+      for (int arc = graph.begin(u); arc < graph.end(u); arc++) {
+        if (!seen[graph.targets[arc]]) {
+          seen[graph.targets[arc]] = true;
+          queue.push_back(graph.targets[arc]);
+        }
+      }
+    }
+    return seen;
+  }
+
+  void checkAgainstSearch(const CompactGraph &graph,
+                          const Reachability &index) {
+    for (int u = 0; u < graph.vertexCount(); u++) {
+      std::vector<bool> seen = reachableFrom(graph, u);
+      for (int v = 0; v < graph.vertexCount(); v++) {
+        Assert::That(index.canReach(u, v), Equals((bool)seen[v]));
+      }
+    }
+  }
+
+  Spec(MatchesSearchForEveryPair) {
+    Reachability index;
+    index.build(g);
+    Assert::That(index.hasClosure(), IsTrue());
+    checkAgainstSearch(g, index);
+  }
+
+  Spec(ComponentsAreMutuallyReachable) {
+    Reachability index;
+    index.build(g);
+    for (int u = 0; u < g.vertexCount(); u++) {
+      std::vector<bool> seen = reachableFrom(g, u);
+      for (int v = 0; v < g.vertexCount(); v++) {
+        bool mutual = seen[v] && reachableFrom(g, v)[u];
+        Assert::That(index.componentOf(u) == index.componentOf(v),
+                     Equals(mutual));
+      }
+    }
+  }
+
+  Spec(AddedVerticesAndArcsKeepItExact) {
+    Reachability index;
+    index.build(g);
+    std::vector<std::vector<int>> adjacency(g.vertexCount());
+    for (int u = 0; u < g.vertexCount(); u++) {
+      for (int arc = g.begin(u); arc < g.end(u); arc++) {
+        adjacency[u].push_back(g.targets[arc]);
+      }
+    }
+
+    // Past 256 components the rows need a fifth word
+    for (int step = 0; step < 300; step++) {
+      if (step % 2 == 0) {
+        index.addVertex();
+        adjacency.push_back(std::vector<int>());
+      }
+      int u = rand() % adjacency.size();
+      int v = rand() % adjacency.size();
+      index.addArc(u, v);
+      adjacency[u].push_back(v);
+    }
+
+    CompactGraph grown;
+    for (std::size_t u = 0; u < adjacency.size(); u++) {
+      grown.addVertex(0, 0);
+      for (int v : adjacency[u]) {
+        grown.addArc(v, 1, 1);
+      }
+    }
+    Assert::That(index.vertexCount(), Equals(350));
+    checkAgainstSearch(grown, index);
+  }
+
+  Spec(GraphRejectsUnreachablePairsWithoutSearching) {
+    Graph graph;
+    Vertex *a = new Vertex("A");
+    Vertex *b = new Vertex("B");
+    Vertex *c = new Vertex("C");
+    graph.addVertex(a);
+    graph.addVertex(b);
+    graph.addVertex(c);
+    graph.addDirectedEdge(a, b, 100, 60);
+    graph.addDirectedEdge(c, b, 100, 60);
+
+    SearchStats stats;
+    Assert::That(graph.search(b, a, CHEAPEST, &stats) == nullptr, IsTrue());
+    Assert::That(stats.settled, Equals(0));
+    Assert::That(graph.searchAll(a, c, FASTEST).empty(), IsTrue());
+    Assert::That(graph.bfs(c, a) == nullptr, IsTrue());
+    Assert::That(graph.lastSettledCount(), Equals(0));
+    Assert::That(graph.search(a, b, CHEAPEST)->totalCost, Equals(100));
+  }
+
+  Spec(GraphUpdatesTheIndexAsRoutesAreAdded) {
+    Graph graph;
+    Vertex *a = new Vertex("A");
+    Vertex *b = new Vertex("B");
+    graph.addVertex(a);
+    graph.addVertex(b);
+    graph.addDirectedEdge(a, b, 100, 60);
+    Assert::That(graph.reachability().componentCount(), Equals(2));
+
+    Vertex *c = new Vertex("C");
+    graph.addVertex(c);
+    graph.addDirectedEdge(b, c, 50, 30);
+    graph.addDirectedEdge(c, a, 50, 30);
+    // Updated in place rather than rebuilt, so the new cycle's airports
+    // keep their separate components
+    const Reachability &index = graph.reachability();
+    Assert::That(index.componentCount(), Equals(3));
+    Assert::That(index.canReach(c->id, b->id), IsTrue());
+    Assert::That(graph.search(c, b, CHEAPEST)->totalCost, Equals(150));
+
+    graph.updateEdge(a->edgeList[0], 120, 60);
+    Assert::That(graph.reachability().componentCount(), Equals(3));
+  }
+};
+
+#endif
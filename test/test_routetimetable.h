@@ -0,0 +1,77 @@
+#ifndef TEST_ROUTE_TIMETABLE_H
+#define TEST_ROUTE_TIMETABLE_H
+
+#include <RouteTimetable.h>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// Route Timetable Tests
+// Tests for grouping timetable trips into routes
+// =============================================================================
+Context(RouteTimetableTests) {
+  Spec(GroupsTripsWithTheSameStops) {
+    Timetable tt(3);
+    for (int start : {600, 300}) {
+      int trip = tt.newTrip();
+      tt.addConnection(0, 1, start, start + 60, 0, trip);
+      tt.addConnection(1, 2, start + 90, start + 150, 0, trip);
+    }
+    tt.addConnection(0, 2, 400, 500);
+    tt.sort();
+
+    RouteTimetable rt(tt);
+    Assert::That(rt.routeCount(), Equals(2));
+    int r = rt.stopCount(0) == 3 ? 0 : 1;
+    Assert::That(rt.tripCount(r), Equals(2));
+    Assert::That(rt.stop(r, 1), Equals(1));
+    Assert::That(rt.departure(r, 0, 0), Equals(300));
+    Assert::That(rt.arrival(r, 1, 2), Equals(750));
+    Assert::That(tt[rt.leg(r, 0, 1)].departure, Equals(390));
+    Assert::That(rt.leg(r, 0, 2), Equals(-1));
+    Assert::That(rt.earliestTrip(r, 1, 400, 2), Equals(1));
+    Assert::That(rt.earliestTrip(r, 1, 700, 2), Equals(2));
+  }
+
+  Spec(SplitsOvertakingTrips) {
+    Timetable tt(3);
+    int slow = tt.newTrip();
+    tt.addConnection(0, 1, 100, 200, 0, slow);
+    tt.addConnection(1, 2, 210, 400, 0, slow);
+    int fast = tt.newTrip();
+    tt.addConnection(0, 1, 150, 190, 0, fast);
+    tt.addConnection(1, 2, 205, 300, 0, fast);
+    tt.sort();
+
+    RouteTimetable rt(tt);
+    Assert::That(rt.routeCount(), Equals(2));
+    Assert::That(rt.tripCount(0), Equals(1));
+    Assert::That(rt.tripCount(1), Equals(1));
+  }
+
+  Spec(ListsTheRoutesServingAStation) {
+    Timetable tt(3);
+    tt.addConnection(0, 1, 100, 200);
+    tt.addConnection(1, 2, 300, 400);
+    tt.sort();
+
+    RouteTimetable rt(tt);
+    Assert::That(rt.servedTo(1) - rt.servedFrom(1), Equals(2));
+    Assert::That(rt.servedTo(0) - rt.servedFrom(0), Equals(1));
+    int i = rt.servedFrom(0);
+    Assert::That(rt.stop(rt.servedRouteAt(i), rt.servedPositionAt(i)),
+                 Equals(0));
+  }
+
+  Spec(RejectsBrokenTrips) {
+    Timetable tt(3);
+    int trip = tt.newTrip();
+    tt.addConnection(0, 1, 100, 200, 0, trip);
+    tt.addConnection(2, 0, 300, 400, 0, trip);
+    tt.sort();
+    AssertThrows(std::logic_error, RouteTimetable(tt));
+  }
+};
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef TEST_SEARCH_STATS_H
+#define TEST_SEARCH_STATS_H
+
+#include <Graph.h>
+#include <SearchStats.h>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// Search Stats Tests
+// Tests for the work counters filled by Graph's search entry points
+// =============================================================================
+Context(SearchStatsTests) {
+  Graph g;
+  Vertex *a;
+  Vertex *b;
+  Vertex *c;
+  Vertex *d;
+
+  void SetUp() {
+    // A -> B ($4), A -> C ($1), C -> B ($2), B -> D ($5)
+    g = Graph();
+    a = new Vertex("A");
+    b = new Vertex("B");
+    c = new Vertex("C");
+    d = new Vertex("D");
+    g.addVertex(a);
+    g.addVertex(b);
+    g.addVertex(c);
+    g.addVertex(d);
+    g.addDirectedEdge(a, b, 4, 60);
+    g.addDirectedEdge(a, c, 1, 60);
+    g.addDirectedEdge(c, b, 2, 60);
+    g.addDirectedEdge(b, d, 5, 60);
+  }
+
+  Spec(SearchCountsHeapOperations) {
+    SearchStats stats;
+    g.search(a, d, CHEAPEST, &stats);
+
+    Assert::That(stats.queries, Equals(1l));
+    Assert::That(stats.settled, Equals(4l));
+    Assert::That(stats.pops, Equals(4l));
+    Assert::That(stats.pushes, Equals(4l));
+    Assert::That(stats.decreaseKeys, Equals(1l));
+    Assert::That(stats.relaxed, Equals(4l));
+    Assert::That(stats.peakFrontier, Equals(2l));
+    Assert::That(stats.bytes > 0, IsTrue());
+    Assert::That(stats.totalMs() >= 0, IsTrue());
+  }
+
+  Spec(StatsAreResetPerQuery) {
+    SearchStats stats;
+    g.search(a, d, CHEAPEST, &stats);
+    g.search(a, c, CHEAPEST, &stats);
+    Assert::That(stats.queries, Equals(1l));
+    Assert::That(stats.settled, Equals(2l));
+  }
+
+  Spec(AggregatesAcrossQueries) {
+    SearchStats total;
+    SearchStats one;
+    g.bfs(a, d, &one);
+    total += one;
+    g.searchBidirectional(a, d, CHEAPEST, &one);
+    total += one;
+    g.searchPareto(a, d, &one);
+    total += one;
+
+    Assert::That(total.queries, Equals(3l));
+    Assert::That(total.settled > one.settled, IsTrue());
+    Assert::That(total.peakFrontier >= one.peakFrontier, IsTrue());
+  }
+
+  Spec(MissingVertexGivesEmptyStats) {
+    SearchStats stats;
+    Vertex outsider("X");
+    g.searchAll(a, &outsider, CHEAPEST, -1, &stats);
+    Assert::That(stats.queries, Equals(1l));
+    Assert::That(stats.settled, Equals(0l));
+  }
+
+  Spec(SummaryMentionsCounters) {
+    SearchStats stats;
+    g.search(a, d, CHEAPEST, &stats);
+    std::string text = stats.summary();
+    Assert::That(text.find("Settled: 4") != std::string::npos, IsTrue());
+    Assert::That(text.find("decrease-keys") != std::string::npos, IsTrue());
+  }
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef TEST_SEARCH_TRACE_H
+#define TEST_SEARCH_TRACE_H
+
+#include <Dijkstra.h>
+#include <Graph.h>
+#include <SearchTrace.h>
+#include <igloo/igloo.h>
+#include <sstream>
+
+using namespace igloo;
+
+// =============================================================================
+// Search Trace Tests
+// Tests for the ring buffer trace sink and the traced Graph searches
+// =============================================================================
+Context(SearchTraceTests) {
+  Spec(RecordsEventsInOrder) {
+    // 0 -> 1 ($4), 0 -> 2 ($1), 2 -> 1 ($2)
+    CompactGraph g;
+    g.addVertex();
+    g.addArc(1, 4, 1);
+    g.addArc(2, 1, 1);
+    g.addVertex();
+    g.addVertex();
+    g.addArc(1, 2, 1);
+
+    Dijkstra engine;
+    RingTrace trace;
+    engine.run(g, 0, -1, CHEAPEST, trace);
+
+    // Expand 0, push 1, push 2, expand 2, decrease 1, expand 1
+    Assert::That(trace.size(), Equals(6));
+    Assert::That(trace[0].kind, Equals(TraceEvent::EXPAND));
+    Assert::That(trace[1].kind, Equals(TraceEvent::PUSH));
+    Assert::That(trace[1].now, Equals(4));
+    Assert::That(trace[4].kind, Equals(TraceEvent::DECREASE));
+    Assert::That(trace[4].vertex, Equals(1));
+    Assert::That(trace[4].was, Equals(4));
+    Assert::That(trace[4].now, Equals(3));
+    Assert::That(trace.dropped(), Equals(0l));
+  }
+
+  Spec(KeepsMostRecentWhenFull) {
+    RingTrace trace(3);
+    for (int i = 0; i < 5; i++) {
+      trace.expand(i);
+    }
+    Assert::That(trace.size(), Equals(3));
+    Assert::That(trace.dropped(), Equals(2l));
+    Assert::That(trace[0].vertex, Equals(2));
+    Assert::That(trace[2].vertex, Equals(4));
+
+    trace.clear();
+    Assert::That(trace.size(), Equals(0));
+  }
+
+  Spec(GraphPrintsTracedSearch) {
+    Graph g;
+    Vertex *a = new Vertex("A");
+    Vertex *b = new Vertex("B");
+    g.addVertex(a);
+    g.addVertex(b);
+    g.addEdge(a, b, 10, 60);
+
+    RingTrace trace;
+    g.bfs(a, b, trace);
+    std::ostringstream out;
+    g.printTrace(trace, out);
+    Assert::That(out.str(), Equals("Expanding A\nAdding B\n"));
+  }
+};
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef TEST_SHORTEST_PATH_TREE_H
+#define TEST_SHORTEST_PATH_TREE_H
+
+#include "fixtures.h"
+#include <Graph.h>
+#include <ShortestPathTree.h>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// Shortest Path Tree Tests
+// Tests for bounded one-to-all trees and isochrones
+// =============================================================================
+Context(ShortestPathTreeTests) {
+  CompactGraph g;
+
+  void SetUp() { g = randomCompactGraph(23, 300, 3); }
+
+  Spec(MatchesDijkstraWithinTheBound) {
+    Dijkstra full;
+    full.run(g, 0, -1, CHEAPEST);
+    int bound = full.distance(g.vertexCount() / 2);
+    if (bound == UNREACHABLE) {
+      bound = 500;
+    }
+
+    Dijkstra engine;
+    ShortestPathTree tree(g, engine, 0, CHEAPEST, bound);
+    checkTreeAgainstDijkstra(g, tree, 0, CHEAPEST, bound);
+    int inside = 0;
+    for (int v = 0; v < g.vertexCount(); v++) {
+      if (full.distance(v) <= bound) {
+        inside++;
+      }
+    }
+    Assert::That(tree.size(), Equals(inside));
+  }
+
+  Spec(ListsVerticesNearestFirst) {
+    Dijkstra engine;
+    ShortestPathTree tree(g, engine, 0, FASTEST, 400);
+    Assert::That(tree.order.front(), Equals(0));
+    for (int i = 1; i < tree.size(); i++) {
+      Assert::That(tree.distance(tree.order[i - 1]) <=
+                       tree.distance(tree.order[i]),
+                   IsTrue());
+      Assert::That(tree.distance(tree.order[i]) <= 400, IsTrue());
+    }
+  }
+
+  Spec(StopsOnceTheBoundIsPassed) {
+    Dijkstra engine;
+    ShortestPathTree tree(g, engine, 0, CHEAPEST, 300);
+    // Only the first airport beyond the bound is settled besides the tree
+    Assert::That(engine.settledVertices() <= tree.size() + 1, IsTrue());
+
+    Dijkstra full;
+    ShortestPathTree everything(g, full, 0, CHEAPEST);
+    Assert::That(everything.size() > tree.size(), IsTrue());
+  }
+
+  Spec(GraphListsTheIsochrone) {
+    Graph graph;
+    Vertex *a = new Vertex("A");
+    Vertex *b = new Vertex("B");
+    Vertex *c = new Vertex("C");
+    Vertex *d = new Vertex("D");
+    graph.addVertex(a);
+    graph.addVertex(b);
+    graph.addVertex(c);
+    graph.addVertex(d);
+    graph.addDirectedEdge(a, b, 300, 60);
+    graph.addDirectedEdge(a, c, 100, 60);
+    graph.addDirectedEdge(c, b, 100, 60);
+    graph.addDirectedEdge(b, d, 500, 60);
+
+    std::vector<std::shared_ptr<Waypoint>> reachable =
+        graph.isochrone(a, CHEAPEST, 400);
+    Assert::That((int)reachable.size(), Equals(2));
+    Assert::That(reachable[0]->vertex, Equals(c));
+    Assert::That(reachable[1]->vertex, Equals(b));
+    Assert::That(reachable[1]->totalCost, Equals(200));
+    Assert::That(reachable[1]->stops, Equals(2));
+
+    ShortestPathTree tree = graph.shortestPathTree(a, CHEAPEST);
+    Assert::That(tree.distance(d->id), Equals(700));
+    Assert::That(tree.parentOf(b->id), Equals(c->id));
+  }
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef TEST_TIMETABLE_H
+#define TEST_TIMETABLE_H
+
+#include <Timetable.h>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// Timetable Tests
+// Tests for the scheduled connection data model
+// =============================================================================
+Context(TimetableTests) {
+  Spec(ParsesAndFormatsClockTimes) {
+    Assert::That(Timetable::parseTime("08:10"), Equals(490));
+    Assert::That(Timetable::parseTime("0:05"), Equals(5));
+    Assert::That(Timetable::formatTime(705), Equals("11:45"));
+    Assert::That(Timetable::formatTime(24 * 60 + 30), Equals("00:30+1"));
+  }
+
+  Spec(RejectsMalformedTimes) {
+    AssertThrows(std::logic_error, Timetable::parseTime("8h10"));
+    AssertThrows(std::logic_error, Timetable::parseTime("08:75"));
+    AssertThrows(std::logic_error, Timetable::parseTime(":10"));
+  }
+
+  Spec(SortsConnectionsByDeparture) {
+    Timetable tt(3, 30);
+    tt.addConnection(0, 1, 600, 700);
+    tt.addConnection(1, 2, 300, 400);
+    tt.addConnection(0, 2, 300, 350);
+    Assert::That(tt.isSorted(), IsFalse());
+
+    tt.sort();
+    Assert::That(tt.isSorted(), IsTrue());
+    Assert::That(tt[0].arrival, Equals(350));
+    Assert::That(tt[1].arrival, Equals(400));
+    Assert::That(tt[2].departure, Equals(600));
+    Assert::That(tt.firstDeparting(301), Equals(2));
+    Assert::That(tt.firstDeparting(900), Equals(3));
+  }
+
+  Spec(SingleLegsGetTheirOwnTrips) {
+    Timetable tt(3);
+    int trip = tt.newTrip();
+    Assert::That(tt.addConnection(0, 1, 10, 20, 100, trip), Equals(trip));
+    Assert::That(tt.addConnection(1, 2, 25, 40, 100, trip), Equals(trip));
+    Assert::That(tt.addConnection(0, 2, 10, 50), Equals(trip + 1));
+    Assert::That(tt.tripCount(), Equals(2));
+  }
+
+  Spec(RejectsInvalidConnections) {
+    Timetable tt(2);
+    AssertThrows(std::logic_error, tt.addConnection(0, 2, 10, 20));
+    AssertThrows(std::logic_error, tt.addConnection(0, 1, 20, 10));
+    // A zero-minute leg could be scanned before the leg that feeds it
+    AssertThrows(std::logic_error, tt.addConnection(0, 1, 20, 20));
+    Assert::That(tt.connectionCount(), Equals(0));
+    AssertThrows(std::logic_error, tt.addConnection(0, 1, 10, 20, 0, 4));
+  }
+};
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef TEST_TOUR_PLANNER_H
+#define TEST_TOUR_PLANNER_H
+
+#include <Graph.h>
+#include <TourPlanner.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <igloo/igloo.h>
+
+using namespace igloo;
+
+// =============================================================================
+// Tour Planner Tests
+// Tests for ordering the stops of multi-city round trips
+// =============================================================================
+Context(TourPlannerTests) {
+  // Home plus k stops with random lengths that differ by direction
+  DistanceTable randomTable(int k) {
+    DistanceTable table(k + 1, k + 1);
+    for (int a = 0; a <= k; a++) {
+      for (int b = 0; b <= k; b++) {
+        table.at(a, b) = a == b ? 0 : 10 + rand() % 500;
+      }
+    }
+    return table;
+  }
+
+  int tourLength(const DistanceTable &table, const std::vector<int> &order) {
+    int total = 0;
+    int at = 0;
+    for (int next : order) {
+      total += table.at(at, next);
+      at = next;
+    }
+    return total + table.at(at, 0);
+  }
+
+  void checkPermutation(const std::vector<int> &order, int k) {
+    std::vector<int> sorted = order;
+    std::sort(sorted.begin(), sorted.end());
+    Assert::That((int)sorted.size(), Equals(k));
+    for (int i = 0; i < k; i++) {
+      Assert::That(sorted[i], Equals(i + 1));
+    }
+  }
+
+  Spec(HeldKarpMatchesEveryOrdering) {
+    srand(25);
+    for (int round = 0; round < 5; round++) {
+      DistanceTable table = randomTable(7);
+      std::vector<int> order;
+      for (int i = 1; i <= 7; i++) {
+        order.push_back(i);
+      }
+      int shortest = UNREACHABLE;
+      do {
+        shortest = std::min(shortest, tourLength(table, order));
+      } while (std::next_permutation(order.begin(), order.end()));
+
+      TourPlanner planner;
+      Tour tour = planner.solve(table);
+      Assert::That(tour.exact, IsTrue());
+      Assert::That(tour.length, Equals(shortest));
+      checkPermutation(tour.order, 7);
+      Assert::That(tourLength(table, tour.order), Equals(shortest));
+    }
+  }
+
+  Spec(ParallelLayersGiveTheSameTour) {
+    srand(26);
+    DistanceTable table = randomTable(EXACT_TOUR_LIMIT);
+    TourPlanner serial;
+    TourPlanner parallel;
+    Tour one = serial.solve(table, 1);
+    Tour four = parallel.solve(table, 4);
+    Assert::That(four.length, Equals(one.length));
+    Assert::That(tourLength(table, four.order), Equals(four.length));
+    Assert::That(parallel.stats().settled, Equals(serial.stats().settled));
+  }
+
+  Spec(LocalSearchUntanglesLargeTours) {
+    // Stops on a circle, shuffled: the best tour goes round it
+    int k = 30;
+    std::vector<int> angle(k + 1);
+    for (int i = 0; i <= k; i++) {
+      angle[i] = i;
+    }
+    srand(27);
+    for (int i = k; i > 1; i--) {
+      std::swap(angle[i], angle[1 + rand() % i]);
+    }
+    DistanceTable table(k + 1, k + 1);
+    for (int a = 0; a <= k; a++) {
+      for (int b = 0; b <= k; b++) {
+        double t = 2 * M_PI * (angle[a] - angle[b]) / (k + 1);
+        double chord = std::sqrt(2 - 2 * std::cos(t));
+        table.at(a, b) = (int)std::lround(1000 * chord);
+      }
+    }
+    int around = 0;
+    for (int i = 0; i <= k; i++) {
+      double t = 2 * M_PI / (k + 1);
+      around += (int)std::lround(1000 * std::sqrt(2 - 2 * std::cos(t)));
+    }
+
+    TourPlanner planner;
+    Tour tour = planner.solve(table);
+    Assert::That(tour.exact, IsFalse());
+    checkPermutation(tour.order, k);
+    Assert::That(tourLength(table, tour.order), Equals(tour.length));
+    Assert::That(tour.length, Equals(around));
+  }
+
+  Spec(ReportsImpossibleTours) {
+    srand(28);
+    DistanceTable table = randomTable(4);
+    for (int a = 0; a <= 4; a++) {
+      table.at(a, 3) = a == 3 ? 0 : UNREACHABLE;
+    }
+    TourPlanner planner;
+    Assert::That(planner.solve(table).length, Equals(UNREACHABLE));
+
+    DistanceTable large = randomTable(20);
+    large.at(0, 5) = UNREACHABLE;
+    Assert::That(planner.solve(large).length < UNREACHABLE, IsTrue());
+    for (int a = 0; a <= 20; a++) {
+      large.at(5, a) = a == 5 ? 0 : UNREACHABLE;
+    }
+    Assert::That(planner.solve(large).length, Equals(UNREACHABLE));
+  }
+
+  Spec(GraphStitchesTheLegs) {
+    Graph graph;
+    Vertex *sfo = new Vertex("SFO");
+    Vertex *nyc = new Vertex("NYC");
+    Vertex *par = new Vertex("PAR");
+    Vertex *jnb = new Vertex("JNB");
+    Vertex *lon = new Vertex("LON");
+    graph.addVertex(sfo);
+    graph.addVertex(nyc);
+    graph.addVertex(par);
+    graph.addVertex(jnb);
+    graph.addVertex(lon);
+    graph.addEdge(sfo, nyc, 300, 5);
+    graph.addEdge(nyc, lon, 400, 7);
+    graph.addEdge(lon, par, 100, 1);
+    graph.addEdge(par, jnb, 700, 11);
+    graph.addEdge(jnb, sfo, 1500, 20);
+    graph.addEdge(sfo, par, 900, 11);
+
+    std::vector<Vertex *> stops = {jnb, nyc, par};
+    SearchStats stats;
+    std::vector<std::shared_ptr<Waypoint>> legs =
+        graph.planTour(sfo, stops, CHEAPEST, 2, &stats);
+    Assert::That((int)legs.size(), Equals(4));
+    int total = 0;
+    for (const std::shared_ptr<Waypoint> &leg : legs) {
+      total += leg->totalCost;
+    }
+    Assert::That(total, Equals(300 + 500 + 700 + 1500));
+    Assert::That(legs[0]->vertex == nyc || legs[0]->vertex == jnb, IsTrue());
+    // NYC and PAR are linked through LON either way round
+    Assert::That(legs[1]->stops == 2 || legs[2]->stops == 2, IsTrue());
+    Assert::That(legs[3]->vertex, Equals(sfo));
+    Assert::That(stats.settled > 0, IsTrue());
+
+    Vertex *island = new Vertex("HNL");
+    graph.addVertex(island);
+    stops.push_back(island);
+    Assert::That(graph.planTour(sfo, stops, CHEAPEST).empty(), IsTrue());
+  }
+};
+
+#endif